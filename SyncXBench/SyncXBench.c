@@ -0,0 +1,493 @@
+/* SyncXBench.c
+
+   Benchmark SyncX objects on the ThreadX Linux port.
+   Sweep r/w lock vs mutex, barriers, task queue and shared array policies, print results as CSV.
+*/
+
+/****************************************************/
+/*    Declarations, Definitions, and Prototypes     */
+/****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "tx_api.h"
+#include "tx_sync.h"
+
+/* Priorities */
+#define BENCH_PRIO_MAIN     1
+#define BENCH_PRIO_WORKER   10
+#define BENCH_PRIO_TASK     10
+
+/* Memory sizes */
+#define STACK_SIZE          8192
+
+/* Quantities */
+#define MAX_THREADS         8
+#define LOCK_OPS            2000
+#define BARRIER_ROUNDS      500
+#define TASK_NUM            2000
+#define PENDING_TASK_NUM    64
+#define ARRAY_OPS           2000
+#define ARRAY_CAPACITY      256
+
+/* Sweeps */
+static const UINT  thread_counts[] = { 1, 2, 4, 8 };
+static const UINT  write_pcts[]    = { 0, 10, 50, 100 };
+static const ULONG work_lens[]     = { 0, 100, 1000 };
+static const ULONG task_lens[]     = { 0, 1000, 10000 };
+
+#define ARRAY_LEN(array)    (sizeof(array)/sizeof((array)[0]))
+
+/* macros */
+
+#define CHECK(action)   { UINT ret = (action); if(TX_SUCCESS != ret) { printf("# %s failed (0x%02X)\n", #action, ret); return; } }
+
+/* Lock under test, dispatched like safe_data in SyncXSample */
+typedef struct BENCH_LOCK_STRUCT
+{
+    CHAR* name;
+    VOID* lock;
+    UINT(*rget)(VOID*, ULONG);
+    UINT(*rput)(VOID*);
+    UINT(*wget)(VOID*, ULONG);
+    UINT(*wput)(VOID*);
+} BENCH_LOCK;
+
+/* Barrier under test */
+typedef struct BENCH_BARRIER_STRUCT
+{
+    CHAR* name;
+    VOID* barrier;
+    UINT(*wait)(VOID*, ULONG);
+    UINT(*reset)(VOID*);
+} BENCH_BARRIER;
+
+/* Shared array policies under test */
+TX_SHARED_ARRAY_DEFINE(BENCH_ARRAY_MUTEX  , bench_array_mutex  , ULONG, ARRAY_CAPACITY, MUTEX)
+TX_SHARED_ARRAY_DEFINE(BENCH_ARRAY_RWLOCK , bench_array_rwlock , ULONG, ARRAY_CAPACITY, RWLOCK)
+TX_SHARED_ARRAY_DEFINE(BENCH_ARRAY_SEQLOCK, bench_array_seqlock, ULONG, ARRAY_CAPACITY, SEQLOCK)
+TX_SHARED_ARRAY_DEFINE(BENCH_ARRAY_NONE   , bench_array_none   , ULONG, ARRAY_CAPACITY, NONE)
+
+/* Shared array under test, NONE policy arrays are limited to one thread */
+typedef struct BENCH_ARRAY_STRUCT
+{
+    CHAR* name;
+    VOID* array;
+    UINT max_threads;
+    UINT(*create)(VOID*, CHAR*);
+    UINT(*remove)(VOID*);
+    VOID(*clear)(VOID*);
+    ULONG(*append)(VOID*, const ULONG*, ULONG);
+    ULONG(*browse)(VOID*, ULONG*, VOID(*)(ULONG, ULONG, ULONG), ULONG);
+} BENCH_ARRAY;
+
+/* Define the ThreadX object control blocks */
+TX_THREAD main_thread;
+TX_THREAD workers[MAX_THREADS];
+TX_LATCH start_gate;
+TX_LATCH done;
+TX_SEMAPHORE round_sem;
+
+TX_MUTEX bench_mutex;
+TX_RWLOCK bench_rwlock;
+TX_RWLOCK_COMPACT bench_rwlock_compact;
+TX_BARRIER bench_barrier;
+TX_BARRIER_COMPACT bench_barrier_compact;
+TX_TASKQ tasks;
+BENCH_ARRAY_MUTEX bench_array_by_mutex;
+BENCH_ARRAY_RWLOCK bench_array_by_rwlock;
+BENCH_ARRAY_SEQLOCK bench_array_by_seqlock;
+BENCH_ARRAY_NONE bench_array_by_none;
+
+UCHAR main_stack[STACK_SIZE];
+UCHAR worker_stacks[MAX_THREADS][STACK_SIZE];
+ULONG taskq_mem[TX_TASKQ_SIZE(PENDING_TASK_NUM) / sizeof(ULONG)];
+
+/* Current configuration and samples */
+static const BENCH_LOCK* cur_lock;
+static const BENCH_BARRIER* cur_barrier;
+static const BENCH_ARRAY* cur_array;
+static UINT cur_write_pct;
+static ULONG cur_work;
+static ULONG64 samples[MAX_THREADS * LOCK_OPS];
+static ULONG64 arrivals[MAX_THREADS];
+static ULONG64 releases[MAX_THREADS];
+static ULONG64 enqueued[TASK_NUM];
+static volatile ULONG browsed_sum;
+
+/* Define thread prototypes. */
+VOID task_bench      (ULONG input);
+VOID lock_worker     (ULONG input);
+VOID barrier_worker  (ULONG input);
+VOID task_timed      (ULONG input);
+VOID array_worker    (ULONG input);
+
+/* Utilities */
+static ULONG64 now_ns(VOID);
+static VOID work(ULONG len);
+static VOID print_result(const char* bench, const char* variant, UINT threads, UINT write_pct, ULONG work_len, ULONG ops, ULONG64 elapsed, ULONG64* lat, ULONG lat_num);
+
+/****************************************************/
+/* Entry Points                                     */
+/****************************************************/
+
+int main()
+{
+    tx_kernel_enter();
+}
+
+void tx_application_define(void* first_unused_memory)
+{
+    CHECK(tx_latch_create(&start_gate, "start", 1));
+    CHECK(tx_latch_create(&done, "done", 0));
+    CHECK(tx_semaphore_create(&round_sem, "round", 0));
+
+    CHECK(tx_mutex_create(&bench_mutex, "mutex", TX_INHERIT));
+    CHECK(tx_rwlock_create(&bench_rwlock, "rwlock", TX_INHERIT));
+    CHECK(tx_rwlock_compact_create(&bench_rwlock_compact));
+
+    CHECK(tx_thread_create(&main_thread, "bench", task_bench, 0, main_stack, STACK_SIZE, BENCH_PRIO_MAIN, BENCH_PRIO_MAIN, TX_NO_TIME_SLICE, TX_AUTO_START));
+}
+
+/****************************************************/
+/* Lock benchmark                                   */
+/****************************************************/
+
+VOID lock_worker(ULONG input)
+{
+    ULONG seed = input + 1;
+    ULONG64* lat = samples + input * LOCK_OPS;
+
+    tx_latch_wait(&start_gate, TX_WAIT_FOREVER);
+    for (UINT i = 0; i < LOCK_OPS; i++)
+    {
+        UINT write;
+        ULONG64 start;
+
+        seed = seed * 1103515245 + 12345;
+        write = ((seed >> 16) % 100) < cur_write_pct;
+
+        start = now_ns();
+        if (write)
+        {
+            cur_lock->wget(cur_lock->lock, TX_WAIT_FOREVER);
+            lat[i] = now_ns() - start;
+            work(cur_work);
+            cur_lock->wput(cur_lock->lock);
+        }
+        else
+        {
+            cur_lock->rget(cur_lock->lock, TX_WAIT_FOREVER);
+            lat[i] = now_ns() - start;
+            work(cur_work);
+            cur_lock->rput(cur_lock->lock);
+        }
+    }
+    tx_latch_count_down(&done, 1);
+}
+
+static VOID run_lock(const BENCH_LOCK* lock, UINT threads, UINT write_pct, ULONG work_len)
+{
+    ULONG64 start;
+
+    cur_lock = lock;
+    cur_write_pct = write_pct;
+    cur_work = work_len;
+    tx_latch_reset(&start_gate, 1);
+    tx_latch_reset(&done, threads);
+    for (UINT i = 0; i < threads; i++)
+    {
+        CHECK(tx_thread_create(workers + i, "worker", lock_worker, i, worker_stacks[i], STACK_SIZE, BENCH_PRIO_WORKER, BENCH_PRIO_WORKER, 1, TX_AUTO_START));
+    }
+    start = now_ns();
+    tx_latch_count_down(&start_gate, 1);
+    tx_latch_wait(&done, TX_WAIT_FOREVER);
+    print_result("lock", lock->name, threads, write_pct, work_len, threads * LOCK_OPS, now_ns() - start, samples, threads * LOCK_OPS);
+    for (UINT i = 0; i < threads; i++)
+    {
+        tx_thread_terminate(workers + i);
+        tx_thread_delete(workers + i);
+    }
+}
+
+/****************************************************/
+/* Barrier benchmark                                */
+/****************************************************/
+
+VOID barrier_worker(ULONG input)
+{
+    for (UINT round = 0; round < BARRIER_ROUNDS; round++)
+    {
+        tx_semaphore_get(&round_sem, TX_WAIT_FOREVER);
+        arrivals[input] = now_ns();
+        cur_barrier->wait(cur_barrier->barrier, TX_WAIT_FOREVER);
+        releases[input] = now_ns();
+        tx_latch_count_down(&done, 1);
+    }
+}
+
+static VOID run_barrier(const BENCH_BARRIER* barrier, UINT threads)
+{
+    ULONG lat_num = 0;
+    ULONG64 elapsed = 0;
+
+    cur_barrier = barrier;
+    for (UINT i = 0; i < threads; i++)
+    {
+        CHECK(tx_thread_create(workers + i, "worker", barrier_worker, i, worker_stacks[i], STACK_SIZE, BENCH_PRIO_WORKER, BENCH_PRIO_WORKER, 1, TX_AUTO_START));
+    }
+    for (UINT round = 0; round < BARRIER_ROUNDS; round++)
+    {
+        ULONG64 start = now_ns();
+        ULONG64 last = 0;
+
+        tx_latch_reset(&done, threads);
+        for (UINT i = 0; i < threads; i++)
+        {
+            tx_semaphore_put(&round_sem);
+        }
+        tx_latch_wait(&done, TX_WAIT_FOREVER);
+        elapsed += now_ns() - start;
+
+        /* Release latency is measured from the last arrival */
+        for (UINT i = 0; i < threads; i++)
+        {
+            last = arrivals[i] > last ? arrivals[i] : last;
+        }
+        for (UINT i = 0; i < threads && lat_num < ARRAY_LEN(samples); i++)
+        {
+            samples[lat_num++] = releases[i] > last ? releases[i] - last : 0;
+        }
+        barrier->reset(barrier->barrier);
+    }
+    print_result("barrier", barrier->name, threads, 0, 0, BARRIER_ROUNDS, elapsed, samples, lat_num);
+    for (UINT i = 0; i < threads; i++)
+    {
+        tx_thread_terminate(workers + i);
+        tx_thread_delete(workers + i);
+    }
+}
+
+/****************************************************/
+/* Task queue benchmark                             */
+/****************************************************/
+
+VOID task_timed(ULONG input)
+{
+    samples[input] = now_ns() - enqueued[input];
+    work(cur_work);
+    tx_latch_count_down(&done, 1);
+}
+
+static VOID run_taskq(UINT runners, ULONG task_len)
+{
+    ULONG64 start;
+
+    cur_work = task_len;
+    CHECK(tx_taskq_create(&tasks, "taskq", taskq_mem, sizeof(taskq_mem)));
+    for (UINT i = 0; i < runners; i++)
+    {
+        CHECK(tx_taskq_create_runner(&tasks, workers + i, "runner", worker_stacks[i], STACK_SIZE));
+    }
+    tx_latch_reset(&done, TASK_NUM);
+    start = now_ns();
+    for (ULONG i = 0; i < TASK_NUM; i++)
+    {
+        enqueued[i] = now_ns();
+        tx_taskq_send(&tasks, task_timed, i, BENCH_PRIO_TASK, BENCH_PRIO_TASK, TX_WAIT_FOREVER);
+    }
+    tx_latch_wait(&done, TX_WAIT_FOREVER);
+    print_result("taskq", "taskq", runners, 0, task_len, TASK_NUM, now_ns() - start, samples, TASK_NUM);
+    for (UINT i = 0; i < runners; i++)
+    {
+        tx_thread_terminate(workers + i);
+        tx_thread_delete(workers + i);
+    }
+    tx_taskq_delete(&tasks);
+}
+
+/****************************************************/
+/* Shared array benchmark                           */
+/****************************************************/
+
+static VOID array_visit(ULONG index, ULONG value, ULONG input)
+{
+    browsed_sum += value;
+}
+
+VOID array_worker(ULONG input)
+{
+    ULONG seed = input + 1;
+    ULONG64* lat = samples + input * ARRAY_OPS;
+
+    tx_latch_wait(&start_gate, TX_WAIT_FOREVER);
+    for (UINT i = 0; i < ARRAY_OPS; i++)
+    {
+        ULONG64 start;
+        ULONG index = 0;
+
+        seed = seed * 1103515245 + 12345;
+
+        start = now_ns();
+        if (((seed >> 16) % 100) < cur_write_pct)
+        {
+            /* Start over once full, so appends keep running */
+            if (0 == cur_array->append(cur_array->array, &seed, 1))
+            {
+                cur_array->clear(cur_array->array);
+            }
+        }
+        else
+        {
+            cur_array->browse(cur_array->array, &index, array_visit, input);
+        }
+        lat[i] = now_ns() - start;
+    }
+    tx_latch_count_down(&done, 1);
+}
+
+static VOID run_array(const BENCH_ARRAY* array, UINT threads, UINT write_pct)
+{
+    ULONG64 start;
+    ULONG fill[ARRAY_CAPACITY / 2];
+
+    cur_array = array;
+    cur_write_pct = write_pct;
+    CHECK(array->create(array->array, array->name));
+
+    /* Browsers start on a half full array */
+    for (ULONG i = 0; i < ARRAY_LEN(fill); i++)
+    {
+        fill[i] = i;
+    }
+    array->append(array->array, fill, ARRAY_LEN(fill));
+
+    tx_latch_reset(&start_gate, 1);
+    tx_latch_reset(&done, threads);
+    for (UINT i = 0; i < threads; i++)
+    {
+        CHECK(tx_thread_create(workers + i, "worker", array_worker, i, worker_stacks[i], STACK_SIZE, BENCH_PRIO_WORKER, BENCH_PRIO_WORKER, 1, TX_AUTO_START));
+    }
+    start = now_ns();
+    tx_latch_count_down(&start_gate, 1);
+    tx_latch_wait(&done, TX_WAIT_FOREVER);
+    print_result("array", array->name, threads, write_pct, 0, threads * ARRAY_OPS, now_ns() - start, samples, threads * ARRAY_OPS);
+    for (UINT i = 0; i < threads; i++)
+    {
+        tx_thread_terminate(workers + i);
+        tx_thread_delete(workers + i);
+    }
+    array->remove(array->array);
+}
+
+/****************************************************/
+/* Main                                             */
+/****************************************************/
+
+VOID task_bench(ULONG input)
+{
+    static const BENCH_LOCK locks[] = {
+        { "mutex"         , &bench_mutex         , (UINT(*)(VOID*, ULONG))tx_mutex_get           , (UINT(*)(VOID*))tx_mutex_put           , (UINT(*)(VOID*, ULONG))tx_mutex_get           , (UINT(*)(VOID*))tx_mutex_put            },
+        { "rwlock"        , &bench_rwlock        , (UINT(*)(VOID*, ULONG))tx_rwlock_rget         , (UINT(*)(VOID*))tx_rwlock_rput         , (UINT(*)(VOID*, ULONG))tx_rwlock_wget         , (UINT(*)(VOID*))tx_rwlock_wput          },
+        { "rwlock_compact", &bench_rwlock_compact, (UINT(*)(VOID*, ULONG))tx_rwlock_compact_rget , (UINT(*)(VOID*))tx_rwlock_compact_rput , (UINT(*)(VOID*, ULONG))tx_rwlock_compact_wget , (UINT(*)(VOID*))tx_rwlock_compact_wput  },
+    };
+    static const BENCH_BARRIER barriers[] = {
+        { "barrier"        , &bench_barrier        , (UINT(*)(VOID*, ULONG))tx_barrier_wait         , (UINT(*)(VOID*))tx_barrier_reset         },
+        { "barrier_compact", &bench_barrier_compact, (UINT(*)(VOID*, ULONG))tx_barrier_compact_wait , (UINT(*)(VOID*))tx_barrier_compact_reset },
+    };
+#define BENCH_ARRAY_ENTRY(name, array, prefix, max_threads) \
+        { name, array, max_threads, (UINT(*)(VOID*, CHAR*))prefix##_create, (UINT(*)(VOID*))prefix##_delete, (VOID(*)(VOID*))prefix##_clear, \
+          (ULONG(*)(VOID*, const ULONG*, ULONG))prefix##_append, (ULONG(*)(VOID*, ULONG*, VOID(*)(ULONG, ULONG, ULONG), ULONG))prefix##_browse }
+    static const BENCH_ARRAY arrays[] = {
+        BENCH_ARRAY_ENTRY("array_mutex"  , &bench_array_by_mutex  , bench_array_mutex  , MAX_THREADS),
+        BENCH_ARRAY_ENTRY("array_rwlock" , &bench_array_by_rwlock , bench_array_rwlock , MAX_THREADS),
+        BENCH_ARRAY_ENTRY("array_seqlock", &bench_array_by_seqlock, bench_array_seqlock, MAX_THREADS),
+        BENCH_ARRAY_ENTRY("array_none"   , &bench_array_by_none   , bench_array_none   , 1),
+    };
+
+    printf("bench,variant,threads,write_pct,work,ops,seconds,throughput,p50_ns,p90_ns,p99_ns,max_ns\n");
+    for (UINT l = 0; l < ARRAY_LEN(locks); l++)
+        for (UINT t = 0; t < ARRAY_LEN(thread_counts); t++)
+            for (UINT w = 0; w < ARRAY_LEN(write_pcts); w++)
+                for (UINT c = 0; c < ARRAY_LEN(work_lens); c++)
+                {
+                    run_lock(locks + l, thread_counts[t], write_pcts[w], work_lens[c]);
+                }
+
+    for (UINT t = 0; t < ARRAY_LEN(thread_counts); t++)
+    {
+        CHECK(tx_barrier_create(&bench_barrier, "barrier", thread_counts[t], TX_INHERIT));
+        CHECK(tx_barrier_compact_create(&bench_barrier_compact, thread_counts[t]));
+        for (UINT b = 0; b < ARRAY_LEN(barriers); b++)
+        {
+            run_barrier(barriers + b, thread_counts[t]);
+        }
+        tx_barrier_delete(&bench_barrier);
+        tx_barrier_compact_delete(&bench_barrier_compact);
+    }
+
+    for (UINT t = 0; t < ARRAY_LEN(thread_counts); t++)
+        for (UINT c = 0; c < ARRAY_LEN(task_lens); c++)
+        {
+            run_taskq(thread_counts[t], task_lens[c]);
+        }
+
+    for (UINT a = 0; a < ARRAY_LEN(arrays); a++)
+        for (UINT t = 0; t < ARRAY_LEN(thread_counts) && thread_counts[t] <= arrays[a].max_threads; t++)
+            for (UINT w = 0; w < ARRAY_LEN(write_pcts); w++)
+            {
+                run_array(arrays + a, thread_counts[t], write_pcts[w]);
+            }
+    exit(0);
+}
+
+/****************************************************/
+/* Utilities                                        */
+/****************************************************/
+
+static ULONG64 now_ns(VOID)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ULONG64)ts.tv_sec * 1000000000ULL + (ULONG64)ts.tv_nsec;
+}
+
+static VOID work(ULONG len)
+{
+    volatile ULONG sink = 0;
+
+    for (ULONG i = 0; i < len; i++)
+    {
+        sink += i;
+    }
+}
+
+static int compare_ns(const void* a, const void* b)
+{
+    ULONG64 x = *(const ULONG64*)a, y = *(const ULONG64*)b;
+
+    return x < y ? -1 : x > y;
+}
+
+static ULONG64 percentile(ULONG64* sorted, ULONG num, UINT pct)
+{
+    return num ? sorted[((ULONG64)(num - 1) * pct) / 100] : 0;
+}
+
+static VOID print_result(const char* bench, const char* variant, UINT threads, UINT write_pct, ULONG work_len, ULONG ops, ULONG64 elapsed, ULONG64* lat, ULONG lat_num)
+{
+    double seconds = elapsed / 1e9;
+
+    qsort(lat, lat_num, sizeof(ULONG64), compare_ns);
+    printf("%s,%s,%u,%u,%lu,%lu,%.6f,%.1f,%llu,%llu,%llu,%llu\n",
+        bench, variant, threads, write_pct, (unsigned long)work_len, (unsigned long)ops, seconds,
+        seconds > 0 ? ops / seconds : 0.0,
+        (unsigned long long)percentile(lat, lat_num, 50),
+        (unsigned long long)percentile(lat, lat_num, 90),
+        (unsigned long long)percentile(lat, lat_num, 99),
+        (unsigned long long)percentile(lat, lat_num, 100));
+    fflush(stdout);
+}
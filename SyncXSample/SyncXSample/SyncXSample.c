@@ -1,6 +1,6 @@
 /* SyncXSample.c
 
-   Create three tasks, a barrier, a mutex and a r/w lock
+   Create a task graph, a mutex and a r/w lock
    Compare mutex vs r/w lock for array access.
 */
 
@@ -31,7 +31,6 @@
 
 /* Durations (ticks) */
 #define GENERATOR_PERIOD    (TX_TIMER_TICKS_PER_SECOND/5)
-#define POLL_PERIOD         (TX_TIMER_TICKS_PER_SECOND/20)
 
 /* Sample data */
 CHAR* pool_names[] = { "th0", "th1", "th2", "th3", "th4", "th5"};
@@ -59,19 +58,17 @@ UCHAR byte_pool_mem[BYTE_POOL_SIZE];
 TX_THREAD pool[THREAD_POOL_SIZE];
 TX_BYTE_POOL byte_pool;
 TX_TASKQ tasks;
-TX_BARRIER barrier;
-TX_SEMAPHORE join;
+TX_TASKQ_GRAPH graph;
+TX_TASKQ_NODE node_clear, node_fill, node_unique, node_process[COUNTER_NUM];
+TX_TASKQ_EDGE edges[COUNTER_NUM + 2];
 
 /* Define task prototypes. */
 VOID task_main          (ULONG input);
+VOID task_clear         (ULONG input);
 VOID task_fill_random   (ULONG input);
 VOID task_update_unique (ULONG input);
 VOID task_process       (ULONG input);
 
-/* Join (aka wait) counters functions */
-VOID join_counters(int count);
-VOID join_counters_callback(TX_TASKQ_ITEM* item, UINT started);
-
 /* Utilities */
 VOID print_progress(const char* title, UINT quantity);
 
@@ -92,11 +89,6 @@ void tx_application_define(void* first_unused_memory)
     /* Init modules */
     CHECK(safe_data_init());
     
-    /* Create sync objects */
-    CHECK(tx_barrier_create(&barrier, "done", 2, TX_INHERIT));
-    CHECK(tx_semaphore_create(&join, "join", 0));
-    tx_taskq_enter_exit_notify(join_counters_callback);
-
     /* Create a memory byte pool for thread stack allocation and task queue. */
     CHECK(tx_byte_pool_create(&byte_pool, "byte pool", byte_pool_mem, BYTE_POOL_SIZE));
 
@@ -110,6 +102,20 @@ void tx_application_define(void* first_unused_memory)
         CHECK(tx_byte_allocate(&byte_pool, pool_stack_ptr+i, STACK_SIZE, TX_NO_WAIT));
         CHECK(tx_taskq_create_runner(&tasks, pool + i, pool_names[i], pool_stack_ptr[i], STACK_SIZE));
     }
+
+    /* Declare the task graph: everything starts once data is cleared.
+       Successors are sent in declaration order: the producer gets a runner before the consumers waiting for its data */
+    CHECK(tx_taskq_graph_create(&graph, "pipeline", &tasks));
+    CHECK(tx_taskq_graph_node_add(&graph, &node_clear , task_clear        , 0, TASK_PRIO_FILL, TASK_PRIO_FILL));
+    CHECK(tx_taskq_graph_node_add(&graph, &node_fill  , task_fill_random  , 0, TASK_PRIO_FILL, TASK_PRIO_FILL));
+    CHECK(tx_taskq_graph_node_add(&graph, &node_unique, task_update_unique, 0, TASK_PRIO_UNIQ, TASK_PRIO_UNIQ));
+    CHECK(tx_taskq_graph_edge_add(&graph, edges + 0, &node_clear, &node_fill));
+    CHECK(tx_taskq_graph_edge_add(&graph, edges + 1, &node_clear, &node_unique));
+    for (UINT i = 0; i < COUNTER_NUM; i++)
+    {
+        CHECK(tx_taskq_graph_node_add(&graph, node_process + i, task_process, i, TASK_PRIO_PROC+i, TASK_PRIO_PROC));
+        CHECK(tx_taskq_graph_edge_add(&graph, edges + 2 + i, &node_clear, node_process + i));
+    }
     
     /* Run main task */
     tx_taskq_send(&tasks, task_main, 0, 1, 1, TX_NO_WAIT);
@@ -139,32 +145,30 @@ VOID task_main(ULONG input)
         /* Start tasks */
         ULONG start = tx_time_get();
 
-        tx_taskq_send(&tasks, task_fill_random  , 0, TASK_PRIO_FILL, TASK_PRIO_FILL, TX_NO_WAIT);
-        tx_barrier_wait(&barrier, TX_WAIT_FOREVER);
-
-        tx_taskq_send(&tasks, task_update_unique, 0, TASK_PRIO_UNIQ, TASK_PRIO_UNIQ, TX_NO_WAIT);
         for (UINT i = 0; i < COUNTER_NUM; i++)
         {
             counters[i].counter = 0;
-            tx_taskq_send(&tasks, task_process, i, TASK_PRIO_PROC+i, TASK_PRIO_PROC, TX_NO_WAIT);
         }
+        tx_taskq_graph_submit(&graph);
 
-        /* Wait for the end of all task process */
-        join_counters(COUNTER_NUM);
+        /* Wait for the end of all tasks */
+        tx_taskq_graph_wait(&graph, TX_WAIT_FOREVER);
 
         printf("- Performance %d\n", tx_time_get() - start);
-        tx_barrier_reset(&barrier);
 
         /* Change the data protection mode */
         use_mutex = !use_mutex;
     }
 }
 
-VOID task_fill_random(ULONG input)
+VOID task_clear(ULONG input)
 {
     srand(0);
     safe_data_clear();
-    tx_barrier_wait(&barrier, TX_WAIT_FOREVER);
+}
+
+VOID task_fill_random(ULONG input)
+{
     for (UINT generated = 0; generated < SAFE_DATA_SIZE; generated += DATA_BLOCK_LEN)
     {
         safe_data_fill_random(DATA_BLOCK_LEN);
@@ -186,12 +190,12 @@ VOID task_update_unique(ULONG input)
         }
         else
         {
-            tx_thread_sleep(POLL_PERIOD);
+            safe_data_wait(updated, TX_WAIT_FOREVER);
         }
     }
 }
 
-static VOID task_process_callback(unsigned index, unsigned value, unsigned long counter_index)
+static VOID task_process_callback(unsigned long index, unsigned value, unsigned long counter_index)
 {
     if (value % counters[counter_index].factor == 0 && safe_data_unique_check(index))
     {
@@ -203,7 +207,7 @@ static VOID task_process_callback(unsigned index, unsigned value, unsigned long
 VOID task_process(ULONG input)
 {
     printf("- Process %d : start\n", input);
-    for (UINT processed = 0; processed < SAFE_DATA_SIZE; )
+    for (ULONG processed = 0; processed < SAFE_DATA_SIZE; )
     {
         if (safe_data_browse(&processed, task_process_callback, input))
         {
@@ -211,7 +215,7 @@ VOID task_process(ULONG input)
         }
         else
         {
-            tx_thread_sleep(POLL_PERIOD);
+            safe_data_wait(processed, TX_WAIT_FOREVER);
         }
     }
 }
@@ -225,18 +229,3 @@ VOID print_progress(const char* title, UINT quantity)
     printf("- %s %d%%\n", title, (quantity * 100) / SAFE_DATA_SIZE);
 }
 
-VOID join_counters_callback(TX_TASKQ_ITEM* item, UINT started)
-{
-    if (!started && item->task_entry_function == task_process)
-    {
-        tx_semaphore_put(&join);
-    }
-}
-
-VOID join_counters(int count)
-{
-    while (count--)
-    {
-        tx_semaphore_get(&join, TX_WAIT_FOREVER);
-    }
-}
@@ -2,13 +2,22 @@
 #include "safe_data.h"
 #include "tx_api.h"
 #include "tx_rwlock.h"
+#include "tx_condvar.h"
+#include "tx_shared_array.h"
 
 #define CHECK(action)   { UINT ret = (action); if(TX_SUCCESS != ret) return ret; }
 
-static unsigned safe_data[SAFE_DATA_SIZE];
-static unsigned int safe_data_len = 0;
-static TX_RWLOCK safe_data_rwlock;
-static TX_MUTEX safe_data_mutex;
+/* Values are generated by blocks to keep the stack of the generating thread small */
+#define SAFE_DATA_BLOCK 16
+
+/* Values array, one per protection mode */
+TX_SHARED_ARRAY_DEFINE(SAFE_DATA_MUTEX , safe_data_mutex , unsigned, SAFE_DATA_SIZE, MUTEX)
+TX_SHARED_ARRAY_DEFINE(SAFE_DATA_RWLOCK, safe_data_rwlock, unsigned, SAFE_DATA_SIZE, RWLOCK)
+
+static SAFE_DATA_MUTEX safe_data_by_mutex;
+static SAFE_DATA_RWLOCK safe_data_by_rwlock;
+static UINT safe_data_rwlocked = TX_FALSE;
+static TX_CONDVAR safe_data_filled;
 
 static unsigned safe_data_unique[SAFE_DATA_SIZE];
 static unsigned int safe_data_unique_last = 0;
@@ -22,31 +31,45 @@ static UINT(*safe_data_wget)(VOID*, ULONG);
 static UINT(*safe_data_rget)(VOID*, ULONG);
 static UINT(*safe_data_wput)(VOID*);
 static UINT(*safe_data_rput)(VOID*);
+static UINT(*safe_data_rwait)(TX_CONDVAR*, VOID*, ULONG);
+
+static UINT safe_data_mutex_wait(TX_CONDVAR* condvar_ptr, VOID* lock_ptr, ULONG wait_option)
+{
+    return tx_condvar_wait(condvar_ptr, (TX_MUTEX*)lock_ptr, wait_option);
+}
+
+static UINT safe_data_rwlock_wait(TX_CONDVAR* condvar_ptr, VOID* lock_ptr, ULONG wait_option)
+{
+    return tx_condvar_rwait(condvar_ptr, (TX_RWLOCK*)lock_ptr, wait_option);
+}
 
 unsigned safe_data_init()
 {
-    safe_data_len = safe_data_unique_last = safe_data_unique_len = 0;
+    safe_data_unique_last = safe_data_unique_len = 0;
     
-    CHECK(tx_rwlock_create(&safe_data_rwlock       , "safe data r/w lock"        , TX_INHERIT));
+    CHECK(safe_data_rwlock_create(&safe_data_by_rwlock , "safe data r/w lock"));
     CHECK(tx_rwlock_create(&safe_data_unique_rwlock, "safe data r/w lock uniques", TX_INHERIT));
-    CHECK(tx_mutex_create (&safe_data_mutex        , "safe data mutex"           , TX_INHERIT));
+    CHECK(safe_data_mutex_create(&safe_data_by_mutex   , "safe data mutex"));
     CHECK(tx_mutex_create (&safe_data_unique_mutex , "safe data mutex uniques"   , TX_INHERIT));
+    CHECK(tx_condvar_create(&safe_data_filled      , "safe data filled"));
     return TX_SUCCESS;
 }
 
 void safe_data_shut()
 {
-    tx_mutex_delete(&safe_data_mutex);
+    safe_data_mutex_delete(&safe_data_by_mutex);
     tx_mutex_delete(&safe_data_unique_mutex);
-    tx_rwlock_delete(&safe_data_rwlock);
+    safe_data_rwlock_delete(&safe_data_by_rwlock);
     tx_rwlock_delete(&safe_data_unique_rwlock);
+    tx_condvar_delete(&safe_data_filled);
 }
 
 void safe_data_clear()
 {
-    safe_data_wget(safe_data_lock, TX_WAIT_FOREVER);
-        safe_data_len = 0;
-    safe_data_wput(safe_data_lock);
+    if (safe_data_rwlocked)
+        safe_data_rwlock_clear(&safe_data_by_rwlock);
+    else
+        safe_data_mutex_clear(&safe_data_by_mutex);
     
     safe_data_wget(safe_data_unique_lock, TX_WAIT_FOREVER);
         safe_data_unique_last = safe_data_unique_len = 0;
@@ -55,100 +78,127 @@ void safe_data_clear()
 
 void safe_data_use_mutex()
 {
-    tx_rwlock_wget(&safe_data_rwlock, TX_WAIT_FOREVER);
+    tx_rwlock_wget(&safe_data_by_rwlock.tx_shared_array_lock, TX_WAIT_FOREVER);
     tx_rwlock_wget(&safe_data_unique_rwlock, TX_WAIT_FOREVER);
     
-    safe_data_lock        = &safe_data_mutex;
+    safe_data_rwlocked    = TX_FALSE;
+    safe_data_lock        = &safe_data_by_mutex.tx_shared_array_lock;
     safe_data_unique_lock = &safe_data_unique_mutex;
 
     safe_data_wget =
     safe_data_rget = tx_mutex_get;
     safe_data_wput =
     safe_data_rput = tx_mutex_put;
+    safe_data_rwait = safe_data_mutex_wait;
 
     tx_rwlock_wput(&safe_data_unique_rwlock);
-    tx_rwlock_wput(&safe_data_rwlock);
+    tx_rwlock_wput(&safe_data_by_rwlock.tx_shared_array_lock);
 }
 
 void safe_data_use_rwlock()
 {
-    tx_mutex_get(&safe_data_mutex, TX_WAIT_FOREVER);
+    tx_mutex_get(&safe_data_by_mutex.tx_shared_array_lock, TX_WAIT_FOREVER);
     tx_mutex_get(&safe_data_unique_mutex, TX_WAIT_FOREVER);
 
-    safe_data_lock = &safe_data_rwlock;
+    safe_data_rwlocked = TX_TRUE;
+    safe_data_lock = &safe_data_by_rwlock.tx_shared_array_lock;
     safe_data_unique_lock = &safe_data_unique_rwlock;
     
     safe_data_wget = tx_rwlock_wget;
     safe_data_rget = tx_rwlock_rget;
     safe_data_wput = tx_rwlock_wput;
     safe_data_rput = tx_rwlock_rput;
+    safe_data_rwait = safe_data_rwlock_wait;
 
     tx_mutex_put(&safe_data_unique_mutex);
-    tx_mutex_put(&safe_data_mutex);    
+    tx_mutex_put(&safe_data_by_mutex.tx_shared_array_lock);    
 }
 
 void safe_data_fill_random(unsigned len)
 {
-    safe_data_wget(safe_data_lock, TX_WAIT_FOREVER);
+    unsigned values[SAFE_DATA_BLOCK];
+    unsigned appended = SAFE_DATA_BLOCK;
+
+    /* Stop once the array is full */
+    while (len && appended == SAFE_DATA_BLOCK)
     {
-        /* Ceil len if too big */
-        if (safe_data_len + len > SAFE_DATA_SIZE)
-        {
-            len = SAFE_DATA_SIZE - safe_data_len;
-        }
-        /* Fill rwldata */
-        for (unsigned i = 0; i < len; i++)
+        unsigned count = len < SAFE_DATA_BLOCK ? len : SAFE_DATA_BLOCK;
+
+        for (unsigned i = 0; i < count; i++)
         {
-            safe_data[safe_data_len++] = (unsigned)rand();
+            values[i] = (unsigned)rand();
         }
+        appended = safe_data_rwlocked
+            ? safe_data_rwlock_append(&safe_data_by_rwlock, values, count)
+            : safe_data_mutex_append(&safe_data_by_mutex, values, count);
+        len -= count;
+
+        /* Wake up threads waiting for new values, they registered before releasing the lock */
+        tx_condvar_broadcast(&safe_data_filled);
     }
-    safe_data_wput(safe_data_lock);
 }
 
-static unsigned _unsafe_data_browse(unsigned* start, void (*process)(unsigned index, unsigned value, unsigned long input), unsigned long input)
+static unsigned _safe_data_length()
+{
+    return safe_data_rwlocked
+        ? safe_data_rwlock_length(&safe_data_by_rwlock)
+        : safe_data_mutex_length(&safe_data_by_mutex);
+}
+
+unsigned safe_data_wait(unsigned start, unsigned long wait_option)
 {
-    unsigned delta = safe_data_len - *start;
+    UINT ret = TX_SUCCESS;
+    unsigned len;
 
-    for (; *start < safe_data_len; (*start)++)
+    safe_data_rget(safe_data_lock, TX_WAIT_FOREVER);
+    while (TX_SUCCESS == ret && _safe_data_length() <= start)
+    {
+        ret = safe_data_rwait(&safe_data_filled, safe_data_lock, wait_option);
+    }
+    if (TX_SUCCESS != ret && TX_NO_INSTANCE != ret && TX_WAIT_ABORTED != ret)
     {
-        process(*start, safe_data[*start], input);
+        /* Lock not obtained again (condition variable deleted or lock error) */
+        return 0;
     }
-    return delta;
+    len = _safe_data_length();
+    safe_data_rput(safe_data_lock);
+    return len > start ? len - start : 0;
 }
 
-
-unsigned safe_data_browse(unsigned* start, void (*process)(unsigned index, unsigned value, unsigned long input), unsigned long input)
+unsigned long safe_data_browse(unsigned long* start, void (*process)(unsigned long index, unsigned value, unsigned long input), unsigned long input)
 {
-    safe_data_rget(safe_data_lock, TX_WAIT_FOREVER);
-    unsigned delta = _unsafe_data_browse(start, process, input);
-    safe_data_rput(safe_data_lock);
-    return delta;
+    return safe_data_rwlocked
+        ? safe_data_rwlock_browse(&safe_data_by_rwlock, start, process, input)
+        : safe_data_mutex_browse(&safe_data_by_mutex, start, process, input);
 }
 
-static void _safe_data_unique_check(unsigned index, unsigned value, unsigned long input)
+/* Called by browse, with read access on the values */
+static void _safe_data_unique_check(unsigned long index, unsigned value, unsigned long input)
 {
-    for (unsigned i = 0; i < index; i++)
+    const unsigned* data = safe_data_rwlocked
+        ? safe_data_by_rwlock.tx_shared_array_data
+        : safe_data_by_mutex.tx_shared_array_data;
+    unsigned i = 0;
+
+    while (i < index && data[i] != value)
     {
-        if (safe_data[i] == value)
-            return;
+        i++;
     }
-    safe_data_unique[safe_data_unique_len++] = index;
+    safe_data_wget(safe_data_unique_lock, TX_WAIT_FOREVER);
+        if (i == index)
+        {
+            safe_data_unique[safe_data_unique_len++] = index;
+        }
+        safe_data_unique_last = index + 1;
+    safe_data_wput(safe_data_unique_lock);
 }
 
 unsigned safe_data_unique_update()
 {
-    unsigned ret;
+    /* Only updated by this function */
+    unsigned long start = safe_data_unique_last;
 
-    //printf("rget safe_data_lock");
-    safe_data_rget(safe_data_lock, TX_WAIT_FOREVER);
-    //    printf("wget safe_data_unique_lock");
-        safe_data_wget(safe_data_unique_lock, TX_WAIT_FOREVER);
-            ret = _unsafe_data_browse(&safe_data_unique_last, _safe_data_unique_check, 0);
-            //    printf("wput safe_data_unique_lock");
-        safe_data_wput(safe_data_unique_lock);
-        //printf("rput safe_data_lock");
-    safe_data_rput(safe_data_lock);
-    return ret;
+    return safe_data_browse(&start, _safe_data_unique_check, 0);
 }
 
 int safe_data_unique_check(unsigned index)
@@ -41,13 +41,21 @@ void safe_data_use_rwlock();
 */
 void safe_data_fill_random(unsigned length);
 
+/**
+* Wait for values to be added after a specific index.
+* @param start Index of the first value to wait for.
+* @param wait_option Defines how long to wait for new values. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for.
+* @return number of values available from start, 0 if none was added within the specified time to wait
+*/
+unsigned safe_data_wait(unsigned start, unsigned long wait_option);
+
 /**
 * Browse safe data using the process function.
 * @param[in,out] start Pointer to the index containing the browsed value index
 * @param process process function to call for each available value
 * @return number of values browsed
 */
-unsigned safe_data_browse(unsigned* start, void (*process)(unsigned index, unsigned value, unsigned long input), unsigned long input);
+unsigned long safe_data_browse(unsigned long* start, void (*process)(unsigned long index, unsigned value, unsigned long input), unsigned long input);
            
 /**
 * Update the unique values index from the recently added values.
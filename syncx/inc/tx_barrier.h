@@ -2,6 +2,7 @@
 #define TX_BARRIER_H
 
 #include "tx_api.h"
+#include "tx_syncx_spin.h"
 
 typedef struct TX_BARRIER_STRUCT
 {
@@ -10,6 +11,9 @@ typedef struct TX_BARRIER_STRUCT
     ULONG tx_barrier_raise_count;
     TX_MUTEX tx_barrier_mtx_counter;
     TX_SEMAPHORE tx_barrier_sem_raise;
+#ifdef TX_SYNCX_ADAPTIVE_SPIN
+    ULONG tx_barrier_spin_budget;
+#endif
 } TX_BARRIER;
 
 /**
@@ -0,0 +1,129 @@
+#ifndef TX_COMPACT_H
+#define TX_COMPACT_H
+
+#include "tx_api.h"
+
+/* Alignment of compact control blocks, e.g. __attribute__((aligned(64))) or __declspec(align(64)) to keep each one in its own cache line */
+#ifndef TX_COMPACT_ALIGN
+#define TX_COMPACT_ALIGN
+#endif
+
+/*
+* Compact objects keep their whole state in a single word and a list of waiters. Each suspended thread links a record
+* with a semaphore created on its own stack, so no kernel object is used while the object is not contended.
+* State and list are updated under tx_interrupt_control like the other SyncX objects: on SMP, this is only atomic
+* if the port locks out the other cores too. No service is called with interrupts disabled.
+* They are not kernel objects, so they have no name and are not registered.
+*/
+
+typedef struct TX_COMPACT_ALIGN TX_RWLOCK_COMPACT_STRUCT
+{
+    ULONG tx_rwlock_compact_state;
+    struct TX_COMPACT_WAITER_STRUCT* tx_rwlock_compact_waiters;
+} TX_RWLOCK_COMPACT;
+
+typedef struct TX_COMPACT_ALIGN TX_BARRIER_COMPACT_STRUCT
+{
+    ULONG tx_barrier_compact_state;
+    ULONG tx_barrier_compact_raise_count;
+    struct TX_COMPACT_WAITER_STRUCT* tx_barrier_compact_waiters;
+} TX_BARRIER_COMPACT;
+
+/**
+* Create a compact read/write lock.
+* @param rwlock_ptr Pointer to a compact r/w lock control block.
+* @retval TX_SUCCESS (0x00) Successful r/w lock creation.
+* @retval TX_PTR_ERROR (0x03) Invalid r/w lock pointer.
+*/
+UINT tx_rwlock_compact_create(TX_RWLOCK_COMPACT* rwlock_ptr);
+
+/**
+* Delete a compact read/write lock. The r/w lock must not be owned. Suspended waiters are resumed with TX_DELETED.
+* @param rwlock_ptr Pointer to a previously created compact r/w lock.
+* @retval TX_SUCCESS(0x00) Successful r/w lock deletion.
+*/
+UINT tx_rwlock_compact_delete(TX_RWLOCK_COMPACT* rwlock_ptr);
+
+/**
+* Obtain access for reading on a compact read/write lock.
+* @param rwlock_ptr Pointer to a previously created compact r/w lock.
+* @param wait_option Defines how the service behaves if the r/w lock is already owned by another thread for writing. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for.
+* @retval TX_SUCCESS (0x00) Successful r/w lock get operation.
+* @retval TX_DELETED (0x01) Object was deleted while thread was suspended.
+* @retval TX_NOT_AVAILABLE (0x1D) Service was unable to get a read access within the specified time to wait.
+* @retval TX_WAIT_ABORTED (0x1A) Suspension was aborted by another thread, timer, or ISR.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Internal waiter semaphore could not be created.
+* @retval TX_WAIT_ERROR (0x04) A wait option other than TX_NO_WAIT was specified on a call from a non-thread.
+*/
+UINT tx_rwlock_compact_rget(TX_RWLOCK_COMPACT* rwlock_ptr, ULONG wait_option);
+
+/**
+* Release access for reading of the compact read/write lock.
+* @param rwlock_ptr Pointer to a previously created compact r/w lock.
+* @retval TX_SUCCESS (0x00) Successful r/w lock release.
+* @retval TX_NOT_OWNED (0x1E) R/w lock is not read.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Internal waiter semaphore could not be put.
+*/
+UINT tx_rwlock_compact_rput(TX_RWLOCK_COMPACT* rwlock_ptr);
+
+/**
+* Obtain exclusive ownership for writing on a compact read/write lock.
+* @param rwlock_ptr Pointer to a previously created compact r/w lock.
+* @param wait_option Defines how the service behaves if the r/w lock is already used by another thread for reading or writing. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for.
+* @retval TX_SUCCESS (0x00) Successful write get of a r/w lock.
+* @retval TX_DELETED (0x01) Object was deleted while thread was suspended.
+* @retval TX_NOT_AVAILABLE (0x1D) Service was unable to get a write access within the specified time to wait.
+* @retval TX_WAIT_ABORTED (0x1A) Suspension was aborted by another thread, timer, or ISR.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Internal waiter semaphore could not be created.
+* @retval TX_WAIT_ERROR (0x04) A wait option other than TX_NO_WAIT was specified on a call from a non-thread.
+*/
+UINT tx_rwlock_compact_wget(TX_RWLOCK_COMPACT* rwlock_ptr, ULONG wait_option);
+
+/**
+* Release ownership for writing of the compact read/write lock.
+* @param rwlock_ptr Pointer to a previously created compact r/w lock.
+* @retval TX_SUCCESS(0x00) Successful r/w lock put.
+* @retval TX_NOT_OWNED (0x1E) R/w lock is not written.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Internal waiter semaphore could not be put.
+*/
+UINT tx_rwlock_compact_wput(TX_RWLOCK_COMPACT* rwlock_ptr);
+
+/**
+* Create a compact barrier.
+* @param barrier_ptr Pointer to a compact barrier control block.
+* @param raise_count Number of call to tx_barrier_compact_wait required to raise the barrier, up to 0xFFFF.
+* @retval TX_SUCCESS (0x00) Successful barrier creation.
+* @retval TX_PTR_ERROR (0x03) Invalid barrier pointer.
+* @retval TX_SIZE_ERROR (0x05) Invalid raise count.
+*/
+UINT tx_barrier_compact_create(TX_BARRIER_COMPACT* barrier_ptr, UINT raise_count);
+
+/**
+* Delete a compact barrier. Suspended waiters are resumed with TX_DELETED.
+* @param barrier_ptr Pointer to a previously created compact barrier.
+* @retval TX_SUCCESS(0x00) Successful barrier deletion.
+*/
+UINT tx_barrier_compact_delete(TX_BARRIER_COMPACT* barrier_ptr);
+
+/**
+* Synchronize the current thread with the other thread using the compact barrier. The barrier stays raised until reset.
+* @param barrier_ptr Pointer to a previously created compact barrier.
+* @param wait_option Defines how the service behaves if no all thread reached the barrier. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for.
+* @retval TX_SUCCESS (0x00) Barrier is raised.
+* @retval TX_DELETED (0x01) Object was deleted while thread was suspended.
+* @retval TX_NO_INSTANCE (0x0D) Barrier is not raised within the specified time to wait. This thread still being counted, it must not retry.
+* @retval TX_WAIT_ABORTED (0x1A) Suspension was aborted by another thread, timer, or ISR. Can be Done by calling tx_barrier_compact_reset.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Internal waiter semaphore could not be created.
+* @retval TX_WAIT_ERROR (0x04) A wait option other than TX_NO_WAIT was specified on a call from a non-thread.
+*/
+UINT tx_barrier_compact_wait(TX_BARRIER_COMPACT* barrier_ptr, ULONG wait_option);
+
+/**
+* Reset the compact barrier, all waiting operation is aborted.
+* @param barrier_ptr Pointer to a previously created compact barrier.
+* @retval TX_SUCCESS (0x00) Successful barrier reset.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Internal waiter semaphore could not be put.
+*/
+UINT tx_barrier_compact_reset(TX_BARRIER_COMPACT* barrier_ptr);
+
+#endif
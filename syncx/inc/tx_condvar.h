@@ -0,0 +1,97 @@
+#ifndef TX_CONDVAR_H
+#define TX_CONDVAR_H
+
+#include "tx_api.h"
+#include "tx_rwlock.h"
+
+typedef struct TX_CONDVAR_STRUCT
+{
+    CHAR* tx_condvar_name;
+    ULONG tx_condvar_waiters;
+    TX_SEMAPHORE tx_condvar_sem_wake;
+} TX_CONDVAR;
+
+/**
+* Create a condition variable.
+* @param condvar_ptr Pointer to a condition variable control block.
+* @param name_ptr Pointer to the name of the condition variable.
+* @retval TX_SUCCESS (0x00) Successful condition variable creation.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal semaphore pointer. Either the pointer is NULL or the condition variable is already created.
+* @retval TX_CALLER_ERROR (0x13) Invalid caller of this service.
+*/
+UINT tx_condvar_create(TX_CONDVAR* condvar_ptr, CHAR* name_ptr);
+
+/**
+* Delete a condition variable. Suspended waiters are resumed with TX_DELETED and do not reacquire their lock.
+* @param condvar_ptr Pointer to a previously created condition variable.
+* @retval TX_SUCCESS(0x00) Successful condition variable deletion.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal counting semaphore pointer.
+* @retval TX_CALLER_ERROR(0x13) Invalid caller of this service.
+*/
+UINT tx_condvar_delete(TX_CONDVAR* condvar_ptr);
+
+/**
+* Atomically release a mutex and wait for the condition variable to be signaled, then obtain the mutex again.
+* The mutex must be owned once by the caller. Spurious wake-ups may occur, the predicate must be checked again on return. If the mutex cannot be obtained again, that error is returned and the mutex is not owned.
+* @param condvar_ptr Pointer to a previously created condition variable.
+* @param mutex_ptr Pointer to a mutex owned by the caller.
+* @param wait_option Defines how long the service waits for a signal. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for. The mutex is obtained again with TX_WAIT_FOREVER in all cases.
+* @retval TX_SUCCESS (0x00) Condition variable signaled, the mutex is owned again.
+* @retval TX_DELETED (0x01) Condition variable was deleted while thread was suspended, the mutex is not owned anymore.
+* @retval TX_NO_INSTANCE (0x0D) Condition variable not signaled within the specified time to wait, the mutex is owned again.
+* @retval TX_WAIT_ABORTED (0x1A) Suspension was aborted by another thread, timer, or ISR, the mutex is owned again.
+* @retval TX_NOT_OWNED (0x1E) Mutex is not owned by caller.
+* @retval TX_MUTEX_ERROR (0x1C) Invalid mutex pointer.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal counting semaphore pointer.
+* @retval TX_WAIT_ERROR (0x04) A wait option other than TX_NO_WAIT was specified on a call from a non-thread.
+*/
+UINT tx_condvar_wait(TX_CONDVAR* condvar_ptr, TX_MUTEX* mutex_ptr, ULONG wait_option);
+
+/**
+* Atomically release a read access on a r/w lock and wait for the condition variable to be signaled, then obtain the read access again.
+* @param condvar_ptr Pointer to a previously created condition variable.
+* @param rwlock_ptr Pointer to a r/w lock read by the caller.
+* @param wait_option Defines how long the service waits for a signal. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for. The read access is obtained again with TX_WAIT_FOREVER in all cases.
+* @retval TX_SUCCESS (0x00) Condition variable signaled, the read access is obtained again.
+* @retval TX_DELETED (0x01) Condition variable was deleted while thread was suspended, the read access is not obtained anymore.
+* @retval TX_NO_INSTANCE (0x0D) Condition variable not signaled within the specified time to wait, the read access is obtained again.
+* @retval TX_WAIT_ABORTED (0x1A) Suspension was aborted by another thread, timer, or ISR, the read access is obtained again.
+* @retval TX_MUTEX_ERROR (0x1C) Invalid internal mutex pointer.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal counting semaphore pointer.
+* @retval TX_WAIT_ERROR (0x04) A wait option other than TX_NO_WAIT was specified on a call from a non-thread.
+* @see tx_rwlock_rget
+*/
+UINT tx_condvar_rwait(TX_CONDVAR* condvar_ptr, TX_RWLOCK* rwlock_ptr, ULONG wait_option);
+
+/**
+* Atomically release a write access on a r/w lock and wait for the condition variable to be signaled, then obtain the write access again.
+* @param condvar_ptr Pointer to a previously created condition variable.
+* @param rwlock_ptr Pointer to a r/w lock written by the caller.
+* @param wait_option Defines how long the service waits for a signal. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for. The write access is obtained again with TX_WAIT_FOREVER in all cases.
+* @retval TX_SUCCESS (0x00) Condition variable signaled, the write access is obtained again.
+* @retval TX_DELETED (0x01) Condition variable was deleted while thread was suspended, the write access is not obtained anymore.
+* @retval TX_NO_INSTANCE (0x0D) Condition variable not signaled within the specified time to wait, the write access is obtained again.
+* @retval TX_WAIT_ABORTED (0x1A) Suspension was aborted by another thread, timer, or ISR, the write access is obtained again.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal counting semaphore pointer.
+* @retval TX_WAIT_ERROR (0x04) A wait option other than TX_NO_WAIT was specified on a call from a non-thread.
+* @see tx_rwlock_wget
+*/
+UINT tx_condvar_wwait(TX_CONDVAR* condvar_ptr, TX_RWLOCK* rwlock_ptr, ULONG wait_option);
+
+/**
+* Wake up one thread waiting on the condition variable, if any. Can be called from threads, timers and ISRs.
+* @param condvar_ptr Pointer to a previously created condition variable.
+* @retval TX_SUCCESS (0x00) Successful condition variable signal.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal counting semaphore pointer.
+*/
+UINT tx_condvar_signal(TX_CONDVAR* condvar_ptr);
+
+/**
+* Wake up all threads waiting on the condition variable. Can be called from threads, timers and ISRs.
+* @param condvar_ptr Pointer to a previously created condition variable.
+* @retval TX_SUCCESS (0x00) Successful condition variable broadcast.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal counting semaphore pointer.
+*/
+UINT tx_condvar_broadcast(TX_CONDVAR* condvar_ptr);
+
+#endif
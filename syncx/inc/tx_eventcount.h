@@ -0,0 +1,74 @@
+#ifndef TX_EVENTCOUNT_H
+#define TX_EVENTCOUNT_H
+
+#include "tx_api.h"
+
+/* Waiter record, lives on the stack of the waiting thread while it is linked to the event count */
+typedef struct TX_EVENTCOUNT_WAITER_STRUCT
+{
+    ULONG tx_eventcount_waiter_target;
+    UINT tx_eventcount_waiter_status;
+    UINT tx_eventcount_waiter_linked;
+    TX_SEMAPHORE tx_eventcount_waiter_sem;
+    struct TX_EVENTCOUNT_WAITER_STRUCT* tx_eventcount_waiter_next;
+} TX_EVENTCOUNT_WAITER;
+
+typedef struct TX_EVENTCOUNT_STRUCT
+{
+    CHAR* tx_eventcount_name;
+    ULONG tx_eventcount_counter;
+    TX_EVENTCOUNT_WAITER* tx_eventcount_waiters;
+} TX_EVENTCOUNT;
+
+/**
+* Create an event count.
+* @param eventcount_ptr Pointer to an event count control block.
+* @param name_ptr Pointer to the name of the event count.
+* @param initial_count Initial value of the counter.
+* @retval TX_SUCCESS (0x00) Successful event count creation.
+*/
+UINT tx_eventcount_create(TX_EVENTCOUNT* eventcount_ptr, CHAR* name_ptr, ULONG initial_count);
+
+/**
+* Delete an event count. Suspended waiters are resumed with TX_DELETED and do not access the event count anymore once this service returns.
+* A thread must not be terminated while waiting on an event count.
+* @param eventcount_ptr Pointer to a previously created event count.
+* @retval TX_SUCCESS(0x00) Successful event count deletion.
+*/
+UINT tx_eventcount_delete(TX_EVENTCOUNT* eventcount_ptr);
+
+/**
+* Advance the counter and resume the threads whose target is reached. Can be called from threads, timers and ISRs.
+* Only an interrupt lockout and an addition are performed when no thread is waiting.
+* @param eventcount_ptr Pointer to a previously created event count.
+* @param increment Value to add to the counter.
+* @retval TX_SUCCESS (0x00) Successful event count advance.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal waiter semaphore pointer.
+*/
+UINT tx_eventcount_advance(TX_EVENTCOUNT* eventcount_ptr, ULONG increment);
+
+/**
+* Wait for the counter to reach a target value. The waiter semaphore is created on the stack of the caller for the duration of the wait.
+* Counter wrap-around is supported as long as the target is less than 2^31 ahead of the counter.
+* @param eventcount_ptr Pointer to a previously created event count.
+* @param target Counter value to wait for.
+* @param wait_option Defines how the service behaves if the counter has not reached the target yet. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for.
+* @retval TX_SUCCESS (0x00) Counter reached the target.
+* @retval TX_DELETED (0x01) Event count was deleted while thread was suspended.
+* @retval TX_NO_INSTANCE (0x0D) Counter did not reach the target within the specified time to wait.
+* @retval TX_WAIT_ABORTED (0x1A) Suspension was aborted by another thread, timer, or ISR.
+* @retval TX_WAIT_ERROR (0x04) A wait option other than TX_NO_WAIT was specified on a call from a non-thread.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Internal waiter semaphore could not be created.
+* @retval TX_CALLER_ERROR (0x13) Invalid caller of this service.
+*/
+UINT tx_eventcount_wait(TX_EVENTCOUNT* eventcount_ptr, ULONG target, ULONG wait_option);
+
+/**
+* Read the current value of the counter.
+* @param eventcount_ptr Pointer to a previously created event count.
+* @return Current value of the counter.
+*/
+#define tx_eventcount_read(eventcount_ptr) \
+    ((eventcount_ptr)->tx_eventcount_counter)
+
+#endif
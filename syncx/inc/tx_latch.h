@@ -0,0 +1,72 @@
+#ifndef TX_LATCH_H
+#define TX_LATCH_H
+
+#include "tx_api.h"
+
+typedef struct TX_LATCH_STRUCT
+{
+    CHAR* tx_latch_name;
+    ULONG tx_latch_count;
+    TX_EVENT_FLAGS_GROUP tx_latch_evt_open;
+} TX_LATCH;
+
+/**
+* Create a countdown latch.
+* @param latch_ptr Pointer to a latch control block.
+* @param name_ptr Pointer to the name of the latch.
+* @param count Number of count down required to open the latch.
+* @retval TX_SUCCESS (0x00) Successful latch creation.
+* @retval TX_GROUP_ERROR (0x06) Invalid internal event flags group pointer. Either the pointer is NULL or the latch is already created.
+* @retval TX_CALLER_ERROR (0x13) Invalid caller of this service.
+*/
+UINT tx_latch_create(TX_LATCH* latch_ptr, CHAR* name_ptr, ULONG count);
+
+/**
+* Delete a countdown latch.
+* @param latch_ptr Pointer to a previously created latch.
+* @retval TX_SUCCESS(0x00) Successful latch deletion.
+* @retval TX_GROUP_ERROR (0x06) Invalid internal event flags group pointer.
+* @retval TX_CALLER_ERROR(0x13) Invalid caller of this service.
+*/
+UINT tx_latch_delete(TX_LATCH* latch_ptr);
+
+/**
+* Decrease the latch count, all waiting threads are resumed at once when it reaches zero. Can be called from threads, timers and ISRs.
+* @param latch_ptr Pointer to a previously created latch.
+* @param count Value to subtract from the latch count. The count does not go below zero.
+* @retval TX_SUCCESS (0x00) Successful latch count down.
+* @retval TX_GROUP_ERROR (0x06) Invalid internal event flags group pointer.
+*/
+UINT tx_latch_count_down(TX_LATCH* latch_ptr, ULONG count);
+
+/**
+* Wait for the latch count to reach zero.
+* @param latch_ptr Pointer to a previously created latch.
+* @param wait_option Defines how the service behaves if the latch is not open yet. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for.
+* @retval TX_SUCCESS (0x00) Latch is open.
+* @retval TX_DELETED (0x01) Latch was deleted while thread was suspended.
+* @retval TX_NO_EVENTS (0x07) Latch was not open within the specified time to wait.
+* @retval TX_WAIT_ABORTED (0x1A) Suspension was aborted by another thread, timer, or ISR.
+* @retval TX_GROUP_ERROR (0x06) Invalid internal event flags group pointer.
+* @retval TX_WAIT_ERROR (0x04) A wait option other than TX_NO_WAIT was specified on a call from a non-thread.
+*/
+UINT tx_latch_wait(TX_LATCH* latch_ptr, ULONG wait_option);
+
+/**
+* Close the latch again with a new count. Must not be called while threads are waiting on the latch.
+* @param latch_ptr Pointer to a previously created latch.
+* @param count Number of count down required to open the latch.
+* @retval TX_SUCCESS (0x00) Successful latch reset.
+* @retval TX_GROUP_ERROR (0x06) Invalid internal event flags group pointer.
+*/
+UINT tx_latch_reset(TX_LATCH* latch_ptr, ULONG count);
+
+/**
+* Read the current count of the latch.
+* @param latch_ptr Pointer to a previously created latch.
+* @return Remaining count down before the latch opens.
+*/
+#define tx_latch_count(latch_ptr) \
+    ((latch_ptr)->tx_latch_count)
+
+#endif
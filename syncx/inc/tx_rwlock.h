@@ -2,6 +2,54 @@
 #define TX_RWLOCK_H
 
 #include "tx_api.h"
+#include "tx_syncx_spin.h"
+
+/* #define TX_RWLOCK_DISABLE_INHERIT */
+#ifndef TX_RWLOCK_MAX_READERS
+#define TX_RWLOCK_MAX_READERS   4
+#endif
+/* #define TX_RWLOCK_ENABLE_ASYNC */
+#ifndef TX_RWLOCK_MAX_ASYNC
+#define TX_RWLOCK_MAX_ASYNC     4
+#endif
+
+/* Writer priority cannot be inherited when write access bypasses the r/w lock services */
+#if defined(TX_RWLOCK_INLINE_WRITE) && !defined(TX_RWLOCK_DISABLE_INHERIT)
+#define TX_RWLOCK_DISABLE_INHERIT
+#endif
+
+/* Pending asynchronous accesses are granted on release, which write access bypasses */
+#if defined(TX_RWLOCK_INLINE_WRITE) && defined(TX_RWLOCK_ENABLE_ASYNC)
+#undef TX_RWLOCK_ENABLE_ASYNC
+#endif
+
+#ifdef TX_RWLOCK_ENABLE_ASYNC
+#include "tx_taskq.h"
+#endif
+
+/* Readers only spin on a write access owned through tx_rwlock_wget, which records the writer */
+#if defined(TX_SYNCX_ADAPTIVE_SPIN) && !defined(TX_RWLOCK_INLINE_WRITE)
+#define TX_RWLOCK_SPIN
+#endif
+
+#ifndef TX_RWLOCK_DISABLE_INHERIT
+typedef struct TX_RWLOCK_READER_STRUCT
+{
+    TX_THREAD* tx_rwlock_reader_thread;
+    UINT tx_rwlock_reader_priority;
+    UINT tx_rwlock_reader_threshold;
+    UINT tx_rwlock_reader_boost;
+} TX_RWLOCK_READER;
+#endif
+
+#ifdef TX_RWLOCK_ENABLE_ASYNC
+typedef struct TX_RWLOCK_ASYNC_STRUCT
+{
+    TX_TASKQ* tx_rwlock_async_taskq;
+    TX_TASKQ_ITEM tx_rwlock_async_task;
+    UINT tx_rwlock_async_write;
+} TX_RWLOCK_ASYNC;
+#endif
 
 typedef struct TX_RWLOCK_STRUCT
 {
@@ -9,13 +57,30 @@ typedef struct TX_RWLOCK_STRUCT
     ULONG tx_rwlock_rcounter;
     TX_MUTEX tx_rwlock_mtx_rcounter;
     TX_SEMAPHORE tx_rwlock_sem_write;
+#ifndef TX_RWLOCK_DISABLE_INHERIT
+    UINT tx_rwlock_inherit;
+    TX_RWLOCK_READER tx_rwlock_readers[TX_RWLOCK_MAX_READERS];
+    ULONG tx_rwlock_untracked;
+    UINT tx_rwlock_writers_pending;
+    volatile UINT tx_rwlock_writers_priority;
+#endif
+#ifdef TX_RWLOCK_ENABLE_ASYNC
+    UINT tx_rwlock_async_first, tx_rwlock_async_count;
+    UINT tx_rwlock_async_granting, tx_rwlock_async_regrant;
+    volatile UINT tx_rwlock_async_stalled;
+    TX_RWLOCK_ASYNC tx_rwlock_async[TX_RWLOCK_MAX_ASYNC];
+#endif
+#ifdef TX_RWLOCK_SPIN
+    TX_THREAD* volatile tx_rwlock_writer;
+    ULONG tx_rwlock_spin_budget;
+#endif
 } TX_RWLOCK;
 
 /**
 * Create a read/write lock.
 * @param rwlock_ptr Pointer to a r/w lock control block.
 * @param name_ptr Pointer to the name of the r/w lock.
-* @param priority_inherit Specifies whether or not this r/w lock supports priority inheritance. If this value is TX_INHERIT, then priority inheritance is supported. However, if TX_NO_INHERIT is specified, priority inheritance is not supported by this r/w lock.
+* @param priority_inherit Specifies whether or not this r/w lock supports priority inheritance. If this value is TX_INHERIT, then priority inheritance is supported: a writer blocked by readers raises the priority of up to TX_RWLOCK_MAX_READERS current readers, and of readers admitted while it waits, to its own until they release their read access. Their preemption threshold is kept, and their priority is not restored if it was changed meanwhile. Readers beyond TX_RWLOCK_MAX_READERS are not raised, they are counted by tx_rwlock_info_get. However, if TX_NO_INHERIT is specified, priority inheritance is not supported by this r/w lock.
 * @retval TX_SUCCESS (0x00) Successful r/w lock creation.
 * @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal semaphore pointer. Either the pointer is NULL or the barrier is already created.
 * @retval TX_MUTEX_ERROR (0x1C) Invalid internal mutex pointer. Either the pointer is NULL or the mutex is already created.
@@ -49,6 +114,16 @@ UINT tx_rwlock_delete(TX_RWLOCK* rwlock_ptr);
 */
 UINT tx_rwlock_rget(TX_RWLOCK* rwlock_ptr, ULONG wait_option);
 
+/**
+* Retrieve information about a read/write lock.
+* @param rwlock_ptr Pointer to a previously created r/w lock.
+* @param name Pointer to destination for the pointer to the r/w lock's name, or TX_NULL.
+* @param readers Pointer to destination for the number of current readers, or TX_NULL.
+* @param untracked Pointer to destination for the number of read accesses not raised by writers because TX_RWLOCK_MAX_READERS readers were already recorded, or TX_NULL.
+* @retval TX_SUCCESS (0x00) Successful r/w lock information retrieval.
+*/
+UINT tx_rwlock_info_get(TX_RWLOCK* rwlock_ptr, CHAR** name, ULONG* readers, ULONG* untracked);
+
 /**
 * Release access for reading of the read/write lock.
 * @param rwlock_ptr Pointer to a previously created r/w lock.
@@ -62,7 +137,7 @@ UINT tx_rwlock_rput(TX_RWLOCK* rwlock_ptr);
 /**
 * Obtain exclusive ownership for writing on a read/write lock.
 * @param rwlock_ptr Pointer to a previously created r/w lock.
-* @param wait_option Defines how the service behaves if the r/w lock is already used by another thread for reading or writing. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for.
+* @param wait_option Defines how the service behaves if the r/w lock is already used by another thread for reading or writing. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for. With priority inheritance, it also bounds the wait for the internal mutex used to raise the readers.
 * @retval TX_SUCCESS (0x00) Successful write get of a r/w lock instance.
 * @retval TX_DELETED (0x01) Internal mutex or counting semaphore was deleted while thread was suspended.
 * @retval TX_NO_INSTANCE (0x0D) Service was unable to get a write access on the r/w lock.
@@ -88,6 +163,48 @@ UINT tx_rwlock_wget(TX_RWLOCK* rwlock_ptr, ULONG wait_option);
 UINT tx_rwlock_wput(TX_RWLOCK* rwlock_ptr);
 #endif
 
+#ifdef TX_RWLOCK_ENABLE_ASYNC
+
+/**
+* Request access for reading on a read/write lock for a task, without blocking. Once read access is granted on its
+* behalf, the task is sent to the task queue; it must release it with tx_rwlock_rput. Pending requests are granted in
+* request order when the r/w lock is released, before the threads suspended on it. If the task queue is full at that
+* time, access is given back and the request stays pending until the next release or a call to tx_rwlock_async_flush.
+* @param rwlock_ptr Pointer to a previously created r/w lock.
+* @param taskq_ptr Pointer to a previously created task queue.
+* @param task_entry_function Specifies the initial C function for task execution. The task ends when it returns from this entry function.
+* @param task_input A 32-bit value that is passed to the task's entry function when it first executes.
+* @param priority Numerical priority of task. Legal values range from 0 through (TX_MAX_PRIORITES-1), where a value of 0 represents the highest priority.
+* @param preemption_treshold Highest priority level (0 through (TX_MAX_PRIORITIES-1)) of disabled preemption. This value must be less than or equal to the specified priority.
+* @retval TX_SUCCESS (0x00) Task sent, or pending until read access is granted.
+* @retval TX_QUEUE_FULL (0x0B) TX_RWLOCK_MAX_ASYNC requests are already pending.
+* @retval TX_CALLER_ERROR (0x13) Invalid caller of this service, it must be called from a thread.
+* @retval TX_NOT_DONE (0x20) Task pending, but access was available and a task queue was full: the task is sent by a later release or call to tx_rwlock_async_flush.
+*/
+UINT tx_rwlock_rget_async(TX_RWLOCK* rwlock_ptr, TX_TASKQ* taskq_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input, UINT priority, UINT preemption_treshold);
+
+/**
+* Request exclusive ownership for writing on a read/write lock for a task, without blocking. Once write access is
+* granted on its behalf, the task is sent to the task queue; it must release it with tx_rwlock_wput.
+* @see tx_rwlock_rget_async
+* @retval TX_SUCCESS (0x00) Task sent, or pending until write access is granted.
+* @retval TX_QUEUE_FULL (0x0B) TX_RWLOCK_MAX_ASYNC requests are already pending.
+* @retval TX_CALLER_ERROR (0x13) Invalid caller of this service, it must be called from a thread.
+* @retval TX_NOT_DONE (0x20) Task pending, but access was available and a task queue was full: the task is sent by a later release or call to tx_rwlock_async_flush.
+*/
+UINT tx_rwlock_wget_async(TX_RWLOCK* rwlock_ptr, TX_TASKQ* taskq_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input, UINT priority, UINT preemption_treshold);
+
+/**
+* Grant pending asynchronous accesses again, after room was made in a full task queue. Never blocks.
+* @param rwlock_ptr Pointer to a previously created r/w lock.
+* @retval TX_SUCCESS (0x00) No request left, or the remaining ones wait for the r/w lock to be released.
+* @retval TX_QUEUE_FULL (0x0B) Access is available but the task queue of the first pending request is still full.
+* @retval TX_CALLER_ERROR (0x13) Invalid caller of this service, it must be called from a thread.
+*/
+UINT tx_rwlock_async_flush(TX_RWLOCK* rwlock_ptr);
+
+#endif
+
 /**
 * Prioritize the read/write lock prioritize list for writing access.
 * @param rwlock_ptr Pointer to a previously created r/w lock.
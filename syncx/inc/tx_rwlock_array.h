@@ -0,0 +1,136 @@
+#ifndef TX_RWLOCK_ARRAY_H
+#define TX_RWLOCK_ARRAY_H
+
+#include "tx_api.h"
+#include "tx_rwlock.h"
+
+/*
+* A r/w lock array stripes a partitioned data structure over several r/w locks: keys or index blocks are mapped
+* to a stripe, so accesses to independent partitions do not contend. Services locking several stripes always
+* take them by increasing stripe number (canonical order) to avoid deadlocks between them.
+*/
+
+typedef struct TX_RWLOCK_ARRAY_STRUCT
+{
+    CHAR* tx_rwlock_array_name;
+    TX_RWLOCK* tx_rwlock_array_stripes;
+    ULONG tx_rwlock_array_count;
+    ULONG tx_rwlock_array_span;
+} TX_RWLOCK_ARRAY;
+
+/**
+* Create a read/write lock array.
+* @param array_ptr Pointer to a r/w lock array control block.
+* @param name_ptr Pointer to the name of the r/w lock array, used by all its stripes.
+* @param stripes Pointer to stripe_count r/w lock control blocks.
+* @param stripe_count Number of stripes.
+* @param span Number of consecutive indexes mapped to the same stripe by tx_rwlock_array_index.
+* @param priority_inherit Specifies whether or not the stripes support priority inheritance, TX_INHERIT or TX_NO_INHERIT.
+* @retval TX_SUCCESS (0x00) Successful r/w lock array creation.
+* @retval TX_SIZE_ERROR (0x05) Stripe count or span is 0.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal semaphore pointer. Either the pointer is NULL or a stripe is already created.
+* @retval TX_MUTEX_ERROR (0x1C) Invalid internal mutex pointer. Either the pointer is NULL or a stripe is already created.
+* @retval TX_INHERIT_ERROR (0x1F) Invalid priority inherit parameter.
+* @retval TX_CALLER_ERROR (0x13) Invalid caller of this service.
+*/
+UINT tx_rwlock_array_create(TX_RWLOCK_ARRAY* array_ptr, CHAR* name_ptr, TX_RWLOCK* stripes, ULONG stripe_count, ULONG span, UINT priority_inherit);
+
+/**
+* Delete a read/write lock array and all its stripes.
+* @param array_ptr Pointer to a previously created r/w lock array.
+* @retval TX_SUCCESS(0x00) Successful r/w lock array deletion.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal counting semaphore pointer.
+* @retval TX_CALLER_ERROR(0x13) Invalid caller of this service.
+*/
+UINT tx_rwlock_array_delete(TX_RWLOCK_ARRAY* array_ptr);
+
+/**
+* Get the stripe of a key.
+* @param array_ptr Pointer to a previously created r/w lock array.
+* @param key Key of the data to access, hashed to spread consecutive keys.
+* @return Pointer to the r/w lock guarding this key.
+*/
+TX_RWLOCK* tx_rwlock_array_key(TX_RWLOCK_ARRAY* array_ptr, ULONG key);
+
+/**
+* Get the stripe of an index: blocks of span consecutive indexes are mapped to stripes in turn.
+* @param array_ptr Pointer to a previously created r/w lock array.
+* @param index Index of the data to access.
+* @return Pointer to the r/w lock guarding this index.
+*/
+#define tx_rwlock_array_index(array_ptr, index) \
+    ((array_ptr)->tx_rwlock_array_stripes + ((index) / (array_ptr)->tx_rwlock_array_span) % (array_ptr)->tx_rwlock_array_count)
+
+/**
+* Obtain access for reading on the stripes of an index range, in canonical order.
+* @param array_ptr Pointer to a previously created r/w lock array.
+* @param first Index of the first data to access.
+* @param count Number of data to access, at least 1.
+* @param wait_option Defines how long to wait for each stripe. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for.
+* @retval TX_SUCCESS (0x00) Successful r/w lock get operation on all the stripes.
+* @retval TX_SIZE_ERROR (0x05) Count is 0.
+* @return Any error of tx_rwlock_rget, stripes already obtained are then released.
+*/
+UINT tx_rwlock_array_rget_range(TX_RWLOCK_ARRAY* array_ptr, ULONG first, ULONG count, ULONG wait_option);
+
+/**
+* Release access for reading on the stripes of an index range.
+* @param array_ptr Pointer to a previously created r/w lock array.
+* @param first Index of the first data accessed.
+* @param count Number of data accessed, as given to tx_rwlock_array_rget_range.
+* @retval TX_SUCCESS (0x00) Successful r/w lock release on all the stripes.
+* @return Any error of tx_rwlock_rput.
+*/
+UINT tx_rwlock_array_rput_range(TX_RWLOCK_ARRAY* array_ptr, ULONG first, ULONG count);
+
+/**
+* Obtain access for writing on the stripes of an index range, in canonical order.
+* @param array_ptr Pointer to a previously created r/w lock array.
+* @param first Index of the first data to access.
+* @param count Number of data to access, at least 1.
+* @param wait_option Defines how long to wait for each stripe. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for.
+* @retval TX_SUCCESS (0x00) Successful r/w lock get operation on all the stripes.
+* @retval TX_SIZE_ERROR (0x05) Count is 0.
+* @return Any error of tx_rwlock_wget, stripes already obtained are then released.
+*/
+UINT tx_rwlock_array_wget_range(TX_RWLOCK_ARRAY* array_ptr, ULONG first, ULONG count, ULONG wait_option);
+
+/**
+* Release access for writing on the stripes of an index range.
+* @param array_ptr Pointer to a previously created r/w lock array.
+* @param first Index of the first data accessed.
+* @param count Number of data accessed, as given to tx_rwlock_array_wget_range.
+* @retval TX_SUCCESS (0x00) Successful r/w lock release on all the stripes.
+* @return Any error of tx_rwlock_wput.
+*/
+UINT tx_rwlock_array_wput_range(TX_RWLOCK_ARRAY* array_ptr, ULONG first, ULONG count);
+
+/**
+* Obtain access for reading on all the stripes, in canonical order, e.g. to browse the whole data structure.
+* @see tx_rwlock_array_rget_range
+*/
+#define tx_rwlock_array_rget_all(array_ptr, wait_option) \
+    tx_rwlock_array_rget_range(array_ptr, 0, (array_ptr)->tx_rwlock_array_count * (array_ptr)->tx_rwlock_array_span, wait_option)
+
+/**
+* Release access for reading on all the stripes.
+* @see tx_rwlock_array_rput_range
+*/
+#define tx_rwlock_array_rput_all(array_ptr) \
+    tx_rwlock_array_rput_range(array_ptr, 0, (array_ptr)->tx_rwlock_array_count * (array_ptr)->tx_rwlock_array_span)
+
+/**
+* Obtain access for writing on all the stripes, in canonical order, e.g. to clear the whole data structure.
+* @see tx_rwlock_array_wget_range
+*/
+#define tx_rwlock_array_wget_all(array_ptr, wait_option) \
+    tx_rwlock_array_wget_range(array_ptr, 0, (array_ptr)->tx_rwlock_array_count * (array_ptr)->tx_rwlock_array_span, wait_option)
+
+/**
+* Release access for writing on all the stripes.
+* @see tx_rwlock_array_wput_range
+*/
+#define tx_rwlock_array_wput_all(array_ptr) \
+    tx_rwlock_array_wput_range(array_ptr, 0, (array_ptr)->tx_rwlock_array_count * (array_ptr)->tx_rwlock_array_span)
+
+#endif
@@ -0,0 +1,215 @@
+#ifndef TX_SHARED_ARRAY_H
+#define TX_SHARED_ARRAY_H
+
+#include "tx_api.h"
+#include "tx_rwlock.h"
+
+/*
+* Shared arrays are fixed capacity arrays that threads append to, browse and clear.
+* The lock policy is chosen at compile time by TX_SHARED_ARRAY_DEFINE, so the lock services are called directly
+* and inlined in each access function instead of being dispatched through function pointers:
+* - MUTEX   : a TX_MUTEX serializes all accesses.
+* - RWLOCK  : a TX_RWLOCK lets browsers run concurrently, appends and clears are exclusive.
+* - SEQLOCK : browsers never lock, they retry a value read concurrently with an append or a clear.
+*             Appends and clears are serialized by a TX_MUTEX.
+* - NONE    : no protection, for arrays owned by a single thread.
+*/
+
+/* Function specifiers of generated services, e.g. static __inline for old compilers */
+#ifndef TX_SHARED_ARRAY_INLINE
+#define TX_SHARED_ARRAY_INLINE  static inline
+#endif
+
+/* Memory barrier used by the SEQLOCK policy: a hardware fence on SMP, else a compiler barrier */
+#if !defined(TX_SHARED_ARRAY_BARRIER) && defined(__GNUC__) && defined(TX_THREAD_SMP_MAX_CORES)
+#define TX_SHARED_ARRAY_BARRIER()   __sync_synchronize()
+#elif !defined(TX_SHARED_ARRAY_BARRIER) && defined(__GNUC__)
+#define TX_SHARED_ARRAY_BARRIER()   __asm__ __volatile__("" ::: "memory")
+#elif !defined(TX_SHARED_ARRAY_BARRIER) && defined(_MSC_VER)
+#include <intrin.h>
+#define TX_SHARED_ARRAY_BARRIER()   _ReadWriteBarrier()
+#elif !defined(TX_SHARED_ARRAY_BARRIER)
+/* Unknown compiler: a kernel call is opaque to the optimizer, so memory is not cached across it */
+#define TX_SHARED_ARRAY_BARRIER()   tx_interrupt_control(tx_interrupt_control(TX_INT_DISABLE))
+#endif
+
+typedef struct TX_SHARED_ARRAY_SEQLOCK_STRUCT
+{
+    TX_MUTEX tx_seqlock_writer;
+    volatile ULONG tx_seqlock_sequence;
+} TX_SHARED_ARRAY_SEQLOCK;
+
+/* MUTEX policy */
+#define _TX_SHARED_ARRAY_LOCK_MUTEX                         TX_MUTEX
+#define _TX_SHARED_ARRAY_CREATE_MUTEX(lock_ptr, name_ptr)   tx_mutex_create(lock_ptr, name_ptr, TX_INHERIT)
+#define _TX_SHARED_ARRAY_DELETE_MUTEX(lock_ptr)             tx_mutex_delete(lock_ptr)
+#define _TX_SHARED_ARRAY_RGET_MUTEX(lock_ptr)               tx_mutex_get(lock_ptr, TX_WAIT_FOREVER)
+#define _TX_SHARED_ARRAY_RPUT_MUTEX(lock_ptr)               tx_mutex_put(lock_ptr)
+#define _TX_SHARED_ARRAY_WGET_MUTEX(lock_ptr)               tx_mutex_get(lock_ptr, TX_WAIT_FOREVER)
+#define _TX_SHARED_ARRAY_WPUT_MUTEX(lock_ptr)               tx_mutex_put(lock_ptr)
+#define _TX_SHARED_ARRAY_READ_MUTEX(prefix, array_ptr, index, value_ptr) \
+    _TX_SHARED_ARRAY_READ_LOCKED(array_ptr, index, value_ptr)
+#define _TX_SHARED_ARRAY_HELPERS_MUTEX(type_name, prefix, value_type)
+
+/* RWLOCK policy */
+#define _TX_SHARED_ARRAY_LOCK_RWLOCK                        TX_RWLOCK
+#define _TX_SHARED_ARRAY_CREATE_RWLOCK(lock_ptr, name_ptr)  tx_rwlock_create(lock_ptr, name_ptr, TX_INHERIT)
+#define _TX_SHARED_ARRAY_DELETE_RWLOCK(lock_ptr)            tx_rwlock_delete(lock_ptr)
+#define _TX_SHARED_ARRAY_RGET_RWLOCK(lock_ptr)              tx_rwlock_rget(lock_ptr, TX_WAIT_FOREVER)
+#define _TX_SHARED_ARRAY_RPUT_RWLOCK(lock_ptr)              tx_rwlock_rput(lock_ptr)
+#define _TX_SHARED_ARRAY_WGET_RWLOCK(lock_ptr)              tx_rwlock_wget(lock_ptr, TX_WAIT_FOREVER)
+#define _TX_SHARED_ARRAY_WPUT_RWLOCK(lock_ptr)              tx_rwlock_wput(lock_ptr)
+#define _TX_SHARED_ARRAY_READ_RWLOCK(prefix, array_ptr, index, value_ptr) \
+    _TX_SHARED_ARRAY_READ_LOCKED(array_ptr, index, value_ptr)
+#define _TX_SHARED_ARRAY_HELPERS_RWLOCK(type_name, prefix, value_type)
+
+/* SEQLOCK policy */
+#define _TX_SHARED_ARRAY_LOCK_SEQLOCK                       TX_SHARED_ARRAY_SEQLOCK
+#define _TX_SHARED_ARRAY_CREATE_SEQLOCK(lock_ptr, name_ptr) \
+    ((lock_ptr)->tx_seqlock_sequence = 0, tx_mutex_create(&((lock_ptr)->tx_seqlock_writer), name_ptr, TX_INHERIT))
+#define _TX_SHARED_ARRAY_DELETE_SEQLOCK(lock_ptr)           tx_mutex_delete(&((lock_ptr)->tx_seqlock_writer))
+#define _TX_SHARED_ARRAY_RGET_SEQLOCK(lock_ptr)
+#define _TX_SHARED_ARRAY_RPUT_SEQLOCK(lock_ptr)
+#define _TX_SHARED_ARRAY_WGET_SEQLOCK(lock_ptr) \
+    tx_mutex_get(&((lock_ptr)->tx_seqlock_writer), TX_WAIT_FOREVER); \
+    (lock_ptr)->tx_seqlock_sequence++; \
+    TX_SHARED_ARRAY_BARRIER()
+#define _TX_SHARED_ARRAY_WPUT_SEQLOCK(lock_ptr) \
+    TX_SHARED_ARRAY_BARRIER(); \
+    (lock_ptr)->tx_seqlock_sequence++; \
+    tx_mutex_put(&((lock_ptr)->tx_seqlock_writer))
+#define _TX_SHARED_ARRAY_READ_SEQLOCK(prefix, array_ptr, index, value_ptr) \
+    _##prefix##_seqlock_read(array_ptr, index, value_ptr)
+#define _TX_SHARED_ARRAY_HELPERS_SEQLOCK(type_name, prefix, value_type) \
+TX_SHARED_ARRAY_INLINE UINT _##prefix##_seqlock_read(type_name* array_ptr, ULONG index, value_type* value_ptr) \
+{ \
+    TX_SHARED_ARRAY_SEQLOCK* lock = &(array_ptr->tx_shared_array_lock); \
+    ULONG sequence; \
+    UINT available; \
+    \
+    while (TX_LOOP_FOREVER) \
+    { \
+        sequence = lock->tx_seqlock_sequence; \
+        if (sequence & 1) \
+        { \
+            /* Writer in progress: wait for it instead of spinning, it may be preempted by this thread */ \
+            tx_mutex_get(&(lock->tx_seqlock_writer), TX_WAIT_FOREVER); \
+            tx_mutex_put(&(lock->tx_seqlock_writer)); \
+            continue; \
+        } \
+        TX_SHARED_ARRAY_BARRIER(); \
+        available = index < array_ptr->tx_shared_array_length; \
+        if (available) \
+        { \
+            *value_ptr = array_ptr->tx_shared_array_data[index]; \
+        } \
+        TX_SHARED_ARRAY_BARRIER(); \
+        if (sequence == lock->tx_seqlock_sequence) \
+        { \
+            return available; \
+        } \
+    } \
+}
+
+/* NONE policy */
+#define _TX_SHARED_ARRAY_LOCK_NONE                          ULONG
+#define _TX_SHARED_ARRAY_CREATE_NONE(lock_ptr, name_ptr)    (*(lock_ptr) = 0, TX_SUCCESS)
+#define _TX_SHARED_ARRAY_DELETE_NONE(lock_ptr)              ((VOID)(lock_ptr), TX_SUCCESS)
+#define _TX_SHARED_ARRAY_RGET_NONE(lock_ptr)
+#define _TX_SHARED_ARRAY_RPUT_NONE(lock_ptr)
+#define _TX_SHARED_ARRAY_WGET_NONE(lock_ptr)
+#define _TX_SHARED_ARRAY_WPUT_NONE(lock_ptr)
+#define _TX_SHARED_ARRAY_READ_NONE(prefix, array_ptr, index, value_ptr) \
+    _TX_SHARED_ARRAY_READ_LOCKED(array_ptr, index, value_ptr)
+#define _TX_SHARED_ARRAY_HELPERS_NONE(type_name, prefix, value_type)
+
+#define _TX_SHARED_ARRAY_READ_LOCKED(array_ptr, index, value_ptr) \
+    ((index) < (array_ptr)->tx_shared_array_length ? (*(value_ptr) = (array_ptr)->tx_shared_array_data[index], TX_TRUE) : TX_FALSE)
+
+/**
+* @brief Define a shared array type and its services.
+* Services are prefix_create, prefix_delete, prefix_clear, prefix_append, prefix_browse and prefix_length.
+* @param type_name Name of the shared array control block type.
+* @param prefix Prefix of the shared array services.
+* @param value_type Type of the array values.
+* @param capacity Max number of values in the array.
+* @param policy Lock policy: MUTEX, RWLOCK, SEQLOCK or NONE.
+*/
+#define TX_SHARED_ARRAY_DEFINE(type_name, prefix, value_type, capacity, policy) \
+typedef struct type_name##_STRUCT \
+{ \
+    CHAR* tx_shared_array_name; \
+    volatile ULONG tx_shared_array_length; \
+    _TX_SHARED_ARRAY_LOCK_##policy tx_shared_array_lock; \
+    value_type tx_shared_array_data[capacity]; \
+} type_name; \
+\
+_TX_SHARED_ARRAY_HELPERS_##policy(type_name, prefix, value_type) \
+\
+/* Create the shared array, empty. Returns the lock creation status. */ \
+TX_SHARED_ARRAY_INLINE UINT prefix##_create(type_name* array_ptr, CHAR* name_ptr) \
+{ \
+    array_ptr->tx_shared_array_name = name_ptr; \
+    array_ptr->tx_shared_array_length = 0; \
+    return _TX_SHARED_ARRAY_CREATE_##policy(&(array_ptr->tx_shared_array_lock), name_ptr); \
+} \
+\
+/* Delete the shared array. Returns the lock deletion status. */ \
+TX_SHARED_ARRAY_INLINE UINT prefix##_delete(type_name* array_ptr) \
+{ \
+    return _TX_SHARED_ARRAY_DELETE_##policy(&(array_ptr->tx_shared_array_lock)); \
+} \
+\
+/* Remove all the values. */ \
+TX_SHARED_ARRAY_INLINE VOID prefix##_clear(type_name* array_ptr) \
+{ \
+    _TX_SHARED_ARRAY_WGET_##policy(&(array_ptr->tx_shared_array_lock)); \
+    array_ptr->tx_shared_array_length = 0; \
+    _TX_SHARED_ARRAY_WPUT_##policy(&(array_ptr->tx_shared_array_lock)); \
+} \
+\
+/* Append count values, ceiled to the remaining capacity. Returns the number of values appended. */ \
+TX_SHARED_ARRAY_INLINE ULONG prefix##_append(type_name* array_ptr, const value_type* values, ULONG count) \
+{ \
+    _TX_SHARED_ARRAY_WGET_##policy(&(array_ptr->tx_shared_array_lock)); \
+    { \
+        ULONG length = array_ptr->tx_shared_array_length; \
+        \
+        if (count > (capacity) - length) \
+        { \
+            count = (capacity) - length; \
+        } \
+        for (ULONG i = 0; i < count; i++) \
+        { \
+            array_ptr->tx_shared_array_data[length + i] = values[i]; \
+        } \
+        array_ptr->tx_shared_array_length = length + count; \
+    } \
+    _TX_SHARED_ARRAY_WPUT_##policy(&(array_ptr->tx_shared_array_lock)); \
+    return count; \
+} \
+\
+/* Call process for each value from *start, *start is updated to the next value index. Returns the number of values browsed. */ \
+/* With the SEQLOCK policy, process is called without lock and may be called for a value cleared meanwhile. */ \
+TX_SHARED_ARRAY_INLINE ULONG prefix##_browse(type_name* array_ptr, ULONG* start, VOID(*process)(ULONG index, value_type value, ULONG input), ULONG input) \
+{ \
+    ULONG first = *start; \
+    value_type value; \
+    \
+    _TX_SHARED_ARRAY_RGET_##policy(&(array_ptr->tx_shared_array_lock)); \
+    while (_TX_SHARED_ARRAY_READ_##policy(prefix, array_ptr, *start, &value)) \
+    { \
+        process(*start, value, input); \
+        (*start)++; \
+    } \
+    _TX_SHARED_ARRAY_RPUT_##policy(&(array_ptr->tx_shared_array_lock)); \
+    return *start - first; \
+} \
+\
+/* Number of values in the array, may be outdated as soon as returned. */ \
+TX_SHARED_ARRAY_INLINE ULONG prefix##_length(type_name* array_ptr) \
+{ \
+    return array_ptr->tx_shared_array_length; \
+}
+
+#endif
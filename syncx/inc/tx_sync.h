@@ -2,7 +2,18 @@
 #define TX_SYNCX_H
 
 #include "tx_taskq.h"
+#include "tx_taskq_graph.h"
+#include "tx_taskq_edf.h"
+#include "tx_taskq_isr.h"
 #include "tx_rwlock.h"
+#include "tx_rwlock_array.h"
 #include "tx_barrier.h"
+#include "tx_compact.h"
+#include "tx_condvar.h"
+#include "tx_eventcount.h"
+#include "tx_latch.h"
+#include "tx_shared_array.h"
+#include "tx_syncx_trace.h"
+#include "tx_syncx_spin.h"
 
 #endif
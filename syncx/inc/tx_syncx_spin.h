@@ -0,0 +1,46 @@
+#ifndef TX_SYNCX_SPIN_H
+#define TX_SYNCX_SPIN_H
+
+#include "tx_api.h"
+
+/*
+* Adaptive spin-then-block: on SMP, a thread that would suspend on a r/w lock or a barrier first polls it for a
+* bounded number of iterations, as short critical sections often end before a suspend/resume round trip would.
+* Each object tunes its own budget from the number of iterations its recent successful spins needed, and gives
+* up spinning as soon as the thread it waits for is not executing on a core anymore.
+*/
+
+/* #define TX_SYNCX_ADAPTIVE_SPIN */
+
+/* Spinning only pays off when the awaited thread runs on another core */
+#if defined(TX_SYNCX_ADAPTIVE_SPIN) && (!defined(TX_THREAD_SMP_MAX_CORES) || TX_THREAD_SMP_MAX_CORES < 2)
+#undef TX_SYNCX_ADAPTIVE_SPIN
+#endif
+
+#ifndef TX_SYNCX_SPIN_MIN
+#define TX_SYNCX_SPIN_MIN       16
+#endif
+#ifndef TX_SYNCX_SPIN_MAX
+#define TX_SYNCX_SPIN_MAX       1024
+#endif
+
+/* CPU relax hint between polls, e.g. __builtin_ia32_pause() or __asm__ volatile("yield") */
+#ifndef TX_SYNCX_SPIN_PAUSE
+#define TX_SYNCX_SPIN_PAUSE()
+#endif
+
+#ifdef TX_SYNCX_ADAPTIVE_SPIN
+
+/**
+* Poll a semaphore before blocking on it (internal).
+* @param semaphore_ptr Pointer to the semaphore to get.
+* @param owner_ptr Thread expected to put the semaphore, spinning stops when it is not executing. TX_NULL if unknown.
+* @param budget_ptr Pointer to the spin budget of the object, updated from the outcome.
+* @retval TX_SUCCESS (0x00) Semaphore instance got while spinning.
+* @retval TX_NO_INSTANCE (0x0D) Caller must block on the semaphore.
+*/
+UINT _tx_syncx_spin_get(TX_SEMAPHORE* semaphore_ptr, TX_THREAD* owner_ptr, ULONG* budget_ptr);
+
+#endif
+
+#endif
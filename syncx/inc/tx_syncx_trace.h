@@ -0,0 +1,49 @@
+#ifndef TX_SYNCX_TRACE_H
+#define TX_SYNCX_TRACE_H
+
+#include "tx_api.h"
+
+/*
+* SyncX events inserted in the ThreadX trace buffer as user events when TX_ENABLE_EVENT_TRACE is defined.
+* Information fields are: object pointer, then event specific values.
+*/
+
+#ifndef TX_SYNCX_TRACE_EVENT_BASE
+#define TX_SYNCX_TRACE_EVENT_BASE       (TX_TRACE_USER_EVENT_START + 0x100)
+#endif
+
+/* R/w lock: rwlock, wait option or readers count */
+#define TX_SYNCX_TRACE_RWLOCK_RGET      (TX_SYNCX_TRACE_EVENT_BASE + 0)
+#define TX_SYNCX_TRACE_RWLOCK_RPUT      (TX_SYNCX_TRACE_EVENT_BASE + 1)
+#define TX_SYNCX_TRACE_RWLOCK_RBLOCK    (TX_SYNCX_TRACE_EVENT_BASE + 2)
+#define TX_SYNCX_TRACE_RWLOCK_WGET      (TX_SYNCX_TRACE_EVENT_BASE + 3)
+#define TX_SYNCX_TRACE_RWLOCK_WPUT      (TX_SYNCX_TRACE_EVENT_BASE + 4)
+#define TX_SYNCX_TRACE_RWLOCK_WBLOCK    (TX_SYNCX_TRACE_EVENT_BASE + 5)
+
+/* Barrier: barrier, arrived count, raise count */
+#define TX_SYNCX_TRACE_BARRIER_ARRIVE   (TX_SYNCX_TRACE_EVENT_BASE + 8)
+#define TX_SYNCX_TRACE_BARRIER_RELEASE  (TX_SYNCX_TRACE_EVENT_BASE + 9)
+#define TX_SYNCX_TRACE_BARRIER_RESET    (TX_SYNCX_TRACE_EVENT_BASE + 10)
+
+/* Task queue: task queue, task entry function, task input, send status for sends or task priority */
+#define TX_SYNCX_TRACE_TASKQ_SEND       (TX_SYNCX_TRACE_EVENT_BASE + 16)
+#define TX_SYNCX_TRACE_TASKQ_FRONT_SEND (TX_SYNCX_TRACE_EVENT_BASE + 17)
+#define TX_SYNCX_TRACE_TASKQ_RECEIVE    (TX_SYNCX_TRACE_EVENT_BASE + 18)
+#define TX_SYNCX_TRACE_TASKQ_START      (TX_SYNCX_TRACE_EVENT_BASE + 19)
+#define TX_SYNCX_TRACE_TASKQ_END        (TX_SYNCX_TRACE_EVENT_BASE + 20)
+
+/* EDF task queue: task queue, task entry function, task input, task deadline */
+#define TX_SYNCX_TRACE_TASKQ_MISS       (TX_SYNCX_TRACE_EVENT_BASE + 21)
+
+/* ISR submission ring: ring, task entry function, task input, overflow or stall count */
+#define TX_SYNCX_TRACE_TASKQ_OVERFLOW   (TX_SYNCX_TRACE_EVENT_BASE + 22)
+#define TX_SYNCX_TRACE_TASKQ_STALL      (TX_SYNCX_TRACE_EVENT_BASE + 23)
+
+#ifdef TX_ENABLE_EVENT_TRACE
+#define TX_SYNCX_TRACE(event_id, info1, info2, info3, info4) \
+    tx_trace_user_event_insert((ULONG)(event_id), (ULONG)(info1), (ULONG)(info2), (ULONG)(info3), (ULONG)(info4))
+#else
+#define TX_SYNCX_TRACE(event_id, info1, info2, info3, info4)
+#endif
+
+#endif
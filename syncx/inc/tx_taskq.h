@@ -2,6 +2,7 @@
 #define TX_TASKQ_H
 
 #include "tx_api.h"
+#include "tx_syncx_trace.h"
 
 #define TX_TASKQ_RUNNER_PRIO    0
 /* #define TX_DISABLE_NOTIFY_CALLBACKS */
@@ -32,6 +33,16 @@ UINT tx_taskq_enter_exit_notify(VOID(*taskq_enter_exit_notify)(TX_TASKQ_ITEM* it
 
 VOID tx_taskq_runner_entry_function(ULONG task_pool_ptr);
 
+/* Run a task received from a task queue in the current runner thread (internal) */
+VOID _tx_taskq_task_run(VOID* taskq_ptr, TX_TASKQ_ITEM* task);
+
+/*
+* Preemption threshold of a task source item (internal): instead of running it, the runner calls its entry function
+* with the address of the received item, which the source replaces with one task to run, or clears the entry function
+* of when it has none. The task then runs as any task received from the task queue.
+*/
+#define TX_TASKQ_SOURCE     TX_MAX_PRIORITIES
+
 /**
 * @brief Create a task queue.
 * @param taskq_ptr Pointer to a task queue control block.
@@ -96,7 +107,9 @@ VOID tx_taskq_runner_entry_function(ULONG task_pool_ptr);
 */
 #define tx_taskq_send(taskq_ptr, task_entry_function, task_input, priority, preemption_treshold, wait_option) { \
         TX_TASKQ_ITEM task = { task_entry_function, task_input, priority, preemption_treshold };                           \
-        tx_queue_send(taskq_ptr, &task, wait_option);                                                                      \
+        UINT task_status = tx_queue_send(taskq_ptr, &task, wait_option);                                                   \
+        TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_SEND, taskq_ptr, task_entry_function, task_input, task_status);                \
+        TX_PARAMETER_NOT_USED(task_status);                                                                                \
     }
 
 /**
@@ -117,7 +130,9 @@ VOID tx_taskq_runner_entry_function(ULONG task_pool_ptr);
 */
 #define tx_taskq_front_send(taskq_ptr, task_entry_function, task_input, priority, preemption_treshold, wait_option) { \
         TX_TASKQ_ITEM task = { task_entry_function, task_input, priority, preemption_treshold };                                 \
-        tx_queue_front_send(taskq_ptr, &task, wait_option);                                                                      \
+        UINT task_status = tx_queue_front_send(taskq_ptr, &task, wait_option);                                                   \
+        TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_FRONT_SEND, taskq_ptr, task_entry_function, task_input, task_status);                \
+        TX_PARAMETER_NOT_USED(task_status);                                                                                      \
     }
 
 /**
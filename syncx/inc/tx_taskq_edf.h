@@ -0,0 +1,105 @@
+#ifndef TX_TASKQ_EDF_H
+#define TX_TASKQ_EDF_H
+
+#include "tx_api.h"
+#include "tx_taskq.h"
+
+typedef struct TX_TASKQ_EDF_ITEM_STRUCT {
+    TX_TASKQ_ITEM task;
+    ULONG task_deadline;
+} TX_TASKQ_EDF_ITEM;
+
+typedef struct TX_TASKQ_EDF_STRUCT
+{
+    CHAR* tx_taskq_edf_name;
+    TX_TASKQ_EDF_ITEM* tx_taskq_edf_heap;
+    ULONG tx_taskq_edf_capacity;
+    ULONG tx_taskq_edf_count;
+    ULONG tx_taskq_edf_misses;
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
+    VOID(*tx_taskq_edf_miss_notify)(struct TX_TASKQ_EDF_STRUCT* taskq_ptr, TX_TASKQ_EDF_ITEM* item);
+#endif
+    TX_SEMAPHORE tx_taskq_edf_sem_pending;
+} TX_TASKQ_EDF;
+
+/**
+* @brief Get the memory size needed for the earliest-deadline-first task queue.
+* @param max_pending_task Max pending task supported by the task queue.
+* @return Memory size needed, in bytes.
+* @see tx_taskq_edf_create
+*/
+#define TX_TASKQ_EDF_SIZE(max_pending_task) ((max_pending_task)*sizeof(TX_TASKQ_EDF_ITEM))
+
+VOID tx_taskq_edf_runner_entry_function(ULONG taskq_ptr);
+
+/**
+* @brief Create an earliest-deadline-first task queue. Runners get pending tasks by deadline order and drop the ones whose deadline passed.
+* @param taskq_ptr Pointer to an EDF task queue control block.
+* @param name_ptr Pointer to the name of the task queue.
+* @param taskq_start Starting address of the task queue. The starting address must be aligned to the size of the ULONG data type.
+* @param taskq_size Total number of bytes available for the task queue, can be found using the TX_TASKQ_EDF_SIZE macro.
+* @retval TX_SUCCESS (0x00) Successful task queue creation.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal semaphore pointer. Either the pointer is NULL or the task queue is already created.
+* @retval TX_PTR_ERROR (0x03) Invalid starting address of the task queue.
+* @retval TX_SIZE_ERROR (0x05) Size of task queue is invalid.
+* @retval TX_CALLER_ERROR (0x13) Invalid caller of this service.
+* @see TX_TASKQ_EDF_SIZE
+*/
+UINT tx_taskq_edf_create(TX_TASKQ_EDF* taskq_ptr, CHAR* name_ptr, VOID* taskq_start, ULONG taskq_size);
+
+/**
+* @brief Delete the EDF task queue, its runners end.
+* @param taskq_ptr Pointer to a previously created EDF task queue.
+* @retval TX_SUCCESS (0x00) Successful task queue deletion.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal semaphore pointer.
+* @retval TX_CALLER_ERROR (0x13) Invalid caller of this service.
+*/
+UINT tx_taskq_edf_delete(TX_TASKQ_EDF* taskq_ptr);
+
+/**
+* @brief Create a thread to run the tasks added to the EDF task queue.
+* @param taskq_ptr Pointer to a previously created EDF task queue.
+* @param thread_ptr Pointer to a thread control block.
+* @param name_ptr Pointer to the name of the thread.
+* @param stack_start Starting address of the stack's memory area.
+* @param stack_size Number bytes in the stack memory area.
+* @retval TX_SUCCESS (0x00) Successful thread creation.
+* @see tx_taskq_create_runner
+*/
+#define tx_taskq_edf_create_runner(taskq_ptr, thread_ptr, name_ptr, stack_start, stack_size) \
+    tx_thread_create(thread_ptr, name_ptr, tx_taskq_edf_runner_entry_function, (ULONG)(taskq_ptr), stack_start, stack_size, TX_TASKQ_RUNNER_PRIO, TX_TASKQ_RUNNER_PRIO, TX_NO_TIME_SLICE, TX_AUTO_START)
+
+/**
+* @brief Send a task with a deadline to the EDF task queue. Never blocks, can be called from threads, timers and ISRs.
+* @param taskq_ptr Pointer to a previously created EDF task queue.
+* @param task_entry_function Specifies the initial C function for task execution. The task ends when it returns from this entry function.
+* @param task_input A 32-bit value that is passed to the task's entry function when it first executes.
+* @param priority Numerical priority of task. Legal values range from 0 through (TX_MAX_PRIORITES-1), where a value of 0 represents the highest priority.
+* @param preemption_treshold Highest priority level (0 through (TX_MAX_PRIORITIES-1)) of disabled preemption. This value must be less than or equal to the specified priority.
+* @param deadline Absolute tick (see tx_time_get) after which the task must not start anymore.
+* @retval TX_SUCCESS (0x00) Successful sending of task.
+* @retval TX_QUEUE_FULL (0x0B) Task queue is full.
+* @retval TX_SEMAPHORE_ERROR (0x0C) Invalid internal semaphore pointer.
+*/
+UINT tx_taskq_edf_send(TX_TASKQ_EDF* taskq_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input, UINT priority, UINT preemption_treshold, ULONG deadline);
+
+/**
+* @brief Notify application when a task is dropped because its deadline passed.
+* @param taskq_ptr Pointer to a previously created EDF task queue.
+* @param taskq_miss_notify a notify function called by the runner instead of the task. TX_NULL to release notification.
+* @retval TX_SUCCESS (0x00) Successful notification registration.
+* @retval TX_FEATURE_NOT_ENABLED (0xFF) The system was compiled with notification capabilities disabled.
+*/
+UINT tx_taskq_edf_miss_notify(TX_TASKQ_EDF* taskq_ptr, VOID(*taskq_miss_notify)(TX_TASKQ_EDF* taskq_ptr, TX_TASKQ_EDF_ITEM* item));
+
+/**
+* @brief Retrieve information about the EDF task queue.
+* @param taskq_ptr Pointer to a previously created EDF task queue.
+* @param name Pointer to destination for the pointer to the task queue's name, or TX_NULL.
+* @param pending Pointer to destination for the number of pending tasks, or TX_NULL.
+* @param misses Pointer to destination for the number of tasks dropped because their deadline passed, or TX_NULL.
+* @retval TX_SUCCESS (0x00) Successful task queue information retrieval.
+*/
+UINT tx_taskq_edf_info_get(TX_TASKQ_EDF* taskq_ptr, CHAR** name, ULONG* pending, ULONG* misses);
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef TX_TASKQ_GRAPH_H
+#define TX_TASKQ_GRAPH_H
+
+#include "tx_api.h"
+#include "tx_taskq.h"
+
+struct TX_TASKQ_GRAPH_STRUCT;
+struct TX_TASKQ_EDGE_STRUCT;
+
+typedef struct TX_TASKQ_NODE_STRUCT
+{
+    VOID(*tx_taskq_node_entry_function)(ULONG);
+    ULONG tx_taskq_node_input;
+    UINT tx_taskq_node_priority, tx_taskq_node_preemption;
+    ULONG tx_taskq_node_dependencies;
+    ULONG tx_taskq_node_pending;
+    struct TX_TASKQ_EDGE_STRUCT* tx_taskq_node_successors;
+    struct TX_TASKQ_NODE_STRUCT* tx_taskq_node_next;
+    struct TX_TASKQ_NODE_STRUCT* tx_taskq_node_deferred;
+    struct TX_TASKQ_GRAPH_STRUCT* tx_taskq_node_graph;
+} TX_TASKQ_NODE;
+
+typedef struct TX_TASKQ_EDGE_STRUCT
+{
+    TX_TASKQ_NODE* tx_taskq_edge_to;
+    struct TX_TASKQ_EDGE_STRUCT* tx_taskq_edge_next;
+} TX_TASKQ_EDGE;
+
+typedef struct TX_TASKQ_GRAPH_STRUCT
+{
+    CHAR* tx_taskq_graph_name;
+    TX_TASKQ* tx_taskq_graph_taskq;
+    TX_TASKQ_NODE* tx_taskq_graph_nodes;
+    ULONG tx_taskq_graph_node_count;
+    ULONG tx_taskq_graph_active;
+    TX_TASKQ_NODE* tx_taskq_graph_deferred;
+    ULONG tx_taskq_graph_remaining;
+    TX_EVENT_FLAGS_GROUP tx_taskq_graph_events;
+} TX_TASKQ_GRAPH;
+
+/**
+* @brief Create a task graph running its tasks on a task queue.
+* @param graph_ptr Pointer to a task graph control block.
+* @param name_ptr Pointer to the name of the task graph.
+* @param taskq_ptr Pointer to a previously created task queue.
+* @retval TX_SUCCESS (0x00) Successful task graph creation.
+* @retval TX_GROUP_ERROR (0x06) Invalid internal event flags group pointer. Either the pointer is NULL or the task graph is already created.
+* @retval TX_CALLER_ERROR (0x13) Invalid caller of this service.
+*/
+UINT tx_taskq_graph_create(TX_TASKQ_GRAPH* graph_ptr, CHAR* name_ptr, TX_TASKQ* taskq_ptr);
+
+/**
+* @brief Delete a task graph. The graph must not be running.
+* @param graph_ptr Pointer to a previously created task graph.
+* @retval TX_SUCCESS (0x00) Successful task graph deletion.
+* @retval TX_GROUP_ERROR (0x06) Invalid internal event flags group pointer.
+* @retval TX_CALLER_ERROR (0x13) Invalid caller of this service.
+*/
+UINT tx_taskq_graph_delete(TX_TASKQ_GRAPH* graph_ptr);
+
+/**
+* @brief Declare a task of the graph.
+* @param graph_ptr Pointer to a previously created task graph, not running.
+* @param node_ptr Pointer to a task node control block, it must remain valid as long as the graph is used.
+* @param task_entry_function Specifies the initial C function for task execution. The task ends when it returns from this entry function.
+* @param task_input A 32-bit value that is passed to the task's entry function when it first executes.
+* @param priority Numerical priority of task. Legal values range from 0 through (TX_MAX_PRIORITES-1), where a value of 0 represents the highest priority.
+* @param preemption_treshold Highest priority level (0 through (TX_MAX_PRIORITIES-1)) of disabled preemption. This value must be less than or equal to the specified priority.
+* @retval TX_SUCCESS (0x00) Successful task declaration.
+* @retval TX_NOT_DONE (0x20) The graph is running.
+*/
+UINT tx_taskq_graph_node_add(TX_TASKQ_GRAPH* graph_ptr, TX_TASKQ_NODE* node_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input, UINT priority, UINT preemption_treshold);
+
+/**
+* @brief Declare a dependency between two tasks of the graph. The graph must remain acyclic.
+* Tasks released by the same task are sent in the order their dependency was declared.
+* @param graph_ptr Pointer to a previously created task graph, not running.
+* @param edge_ptr Pointer to a task edge control block, it must remain valid as long as the graph is used.
+* @param from_ptr Pointer to the task that must end first.
+* @param to_ptr Pointer to the task that can only start once from_ptr ended.
+* @retval TX_SUCCESS (0x00) Successful dependency declaration.
+* @retval TX_PTR_ERROR (0x03) Tasks do not belong to this graph.
+* @retval TX_NOT_DONE (0x20) The graph is running.
+*/
+UINT tx_taskq_graph_edge_add(TX_TASKQ_GRAPH* graph_ptr, TX_TASKQ_EDGE* edge_ptr, TX_TASKQ_NODE* from_ptr, TX_TASKQ_NODE* to_ptr);
+
+/**
+* @brief Run the graph: tasks without dependency are sent to the task queue, others are sent as soon as all the tasks they depend on ended.
+* When the task queue is full, a released task is deferred until another task of the graph ends. Runners never wait for room in the task queue:
+* when no task of the graph is active anymore, deferred tasks are sent by tx_taskq_graph_wait.
+* @param graph_ptr Pointer to a previously created task graph, not running.
+* @retval TX_SUCCESS (0x00) Successful graph submission.
+* @retval TX_NOT_DONE (0x20) The graph is already running.
+* @retval TX_GROUP_ERROR (0x06) Invalid internal event flags group pointer.
+*/
+UINT tx_taskq_graph_submit(TX_TASKQ_GRAPH* graph_ptr);
+
+/**
+* @brief Wait for the end of all the tasks of a submitted graph, it can then be submitted again.
+* Tasks deferred while no other task of the graph is active are sent meanwhile, waiting for room in the task queue within the specified time to wait.
+* @param graph_ptr Pointer to a previously created task graph.
+* @param wait_option Defines how the service behaves if the graph is still running. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for.
+* @retval TX_SUCCESS (0x00) All the tasks ended.
+* @retval TX_DELETED (0x01) Task graph was deleted while thread was suspended.
+* @retval TX_NO_EVENTS (0x07) Tasks did not end within the specified time to wait.
+* @retval TX_WAIT_ABORTED (0x1A) Suspension was aborted by another thread, timer, or ISR.
+* @retval TX_GROUP_ERROR (0x06) Invalid internal event flags group pointer.
+* @retval TX_QUEUE_ERROR (0x09) Invalid task queue pointer.
+* @retval TX_WAIT_ERROR (0x04) A wait option other than TX_NO_WAIT was specified on a call from a non-thread.
+*/
+UINT tx_taskq_graph_wait(TX_TASKQ_GRAPH* graph_ptr, ULONG wait_option);
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef TX_TASKQ_ISR_H
+#define TX_TASKQ_ISR_H
+
+#include "tx_api.h"
+#include "tx_taskq.h"
+
+/*
+* ISR submission ring of a task queue: interrupt handlers push tasks in a lock-free multi-producer ring instead of
+* entering the kernel for each task. The first task pushed in an empty ring sends a drain item to the front of the
+* task queue; the runner receiving it pops one task and runs it as its own task, after sending another drain item to
+* the back of the task queue if the ring is not empty yet.
+*/
+
+typedef struct TX_TASKQ_ISR_SLOT_STRUCT
+{
+    TX_TASKQ_ITEM tx_taskq_isr_slot_task;
+    volatile ULONG tx_taskq_isr_slot_sequence;
+} TX_TASKQ_ISR_SLOT;
+
+typedef struct TX_TASKQ_ISR_STRUCT
+{
+    CHAR* tx_taskq_isr_name;
+    TX_TASKQ* tx_taskq_isr_taskq;
+    TX_TASKQ_ISR_SLOT* tx_taskq_isr_slots;
+    ULONG tx_taskq_isr_mask;
+    volatile ULONG tx_taskq_isr_head;
+    volatile ULONG tx_taskq_isr_tail;
+    volatile ULONG tx_taskq_isr_drain_pending;
+    volatile ULONG tx_taskq_isr_overflows;
+    volatile ULONG tx_taskq_isr_stalls;
+} TX_TASKQ_ISR;
+
+/**
+* @brief Get the memory size needed for an ISR submission ring.
+* @param max_pending_task Max pending task in the ring, must be a power of two.
+* @return Memory size needed, in bytes.
+* @see tx_taskq_isr_create
+*/
+#define TX_TASKQ_ISR_SIZE(max_pending_task) ((max_pending_task)*sizeof(TX_TASKQ_ISR_SLOT))
+
+/**
+* @brief Create an ISR submission ring for a task queue.
+* @param isr_ptr Pointer to an ISR submission ring control block.
+* @param name_ptr Pointer to the name of the ring.
+* @param taskq_ptr Pointer to a previously created task queue running the submitted tasks.
+* @param ring_start Starting address of the ring. The starting address must be aligned to the size of the ULONG data type.
+* @param ring_size Total number of bytes available for the ring, can be found using the TX_TASKQ_ISR_SIZE macro.
+* @retval TX_SUCCESS (0x00) Successful ring creation.
+* @retval TX_PTR_ERROR (0x03) Invalid task queue or starting address of the ring.
+* @retval TX_SIZE_ERROR (0x05) Number of slots is not a power of two.
+*/
+UINT tx_taskq_isr_create(TX_TASKQ_ISR* isr_ptr, CHAR* name_ptr, TX_TASKQ* taskq_ptr, VOID* ring_start, ULONG ring_size);
+
+/**
+* @brief Delete an ISR submission ring. Tasks still in the ring are not run.
+* @param isr_ptr Pointer to a previously created ISR submission ring, no drain item must be pending.
+* @retval TX_SUCCESS (0x00) Successful ring deletion.
+*/
+UINT tx_taskq_isr_delete(TX_TASKQ_ISR* isr_ptr);
+
+/**
+* @brief Submit a task from an ISR, a timer or a thread. Never blocks.
+* @param isr_ptr Pointer to a previously created ISR submission ring.
+* @param task_entry_function Specifies the initial C function for task execution. The task ends when it returns from this entry function.
+* @param task_input A 32-bit value that is passed to the task's entry function when it first executes.
+* @param priority Numerical priority of task. Legal values range from 0 through (TX_MAX_PRIORITES-1), where a value of 0 represents the highest priority.
+* @param preemption_treshold Highest priority level (0 through (TX_MAX_PRIORITIES-1)) of disabled preemption. This value must be less than or equal to the specified priority.
+* @retval TX_SUCCESS (0x00) Task is in the ring.
+* @retval TX_QUEUE_FULL (0x0B) Ring is full, the task is dropped and counted as an overflow.
+* @retval TX_NOT_DONE (0x20) Task is in the ring, but the task queue was full: the drain item could not be sent and the stall is counted. Tasks of the ring run after a later submission or a call to tx_taskq_isr_flush.
+*/
+UINT tx_taskq_isr_send(TX_TASKQ_ISR* isr_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input, UINT priority, UINT preemption_treshold);
+
+/**
+* @brief Make sure the tasks of the ring get run, waiting for room in the task queue if needed. Recovers from a stall reported by tx_taskq_isr_send.
+* @param isr_ptr Pointer to a previously created ISR submission ring.
+* @param wait_option Defines how the service behaves if the task queue is full. Can be TX_NO_WAIT, TX_WAIT_FOREVER or a positive number of ticks to wait for.
+* @retval TX_SUCCESS (0x00) Ring is empty, or a drain item is pending.
+* @retval TX_QUEUE_FULL (0x0B) Task queue is still full after the specified time to wait.
+* @retval TX_WAIT_ABORTED (0x1A) Suspension was aborted by another thread, timer, or ISR.
+* @retval TX_WAIT_ERROR (0x04) A wait option other than TX_NO_WAIT was specified on a call from a non-thread.
+*/
+UINT tx_taskq_isr_flush(TX_TASKQ_ISR* isr_ptr, ULONG wait_option);
+
+/**
+* @brief Retrieve information about an ISR submission ring.
+* @param isr_ptr Pointer to a previously created ISR submission ring.
+* @param name Pointer to destination for the pointer to the ring's name, or TX_NULL.
+* @param pending Pointer to destination for the number of tasks in the ring, or TX_NULL.
+* @param overflows Pointer to destination for the number of tasks dropped because the ring was full, or TX_NULL.
+* @param stalls Pointer to destination for the number of drain items that could not be sent because the task queue was full, or TX_NULL.
+* @retval TX_SUCCESS (0x00) Successful ring information retrieval.
+*/
+UINT tx_taskq_isr_info_get(TX_TASKQ_ISR* isr_ptr, CHAR** name, ULONG* pending, ULONG* overflows, ULONG* stalls);
+
+#endif
@@ -1,10 +1,14 @@
 #include "tx_barrier.h"
+#include "tx_syncx_trace.h"
 
 UINT tx_barrier_create(TX_BARRIER* barrier_ptr, CHAR* name_ptr, UINT raise_count, UINT inherit)
 {
     barrier_ptr->tx_barrier_name = name_ptr;
     barrier_ptr->tx_barrier_counter = 0;
     barrier_ptr->tx_barrier_raise_count = raise_count;
+#ifdef TX_SYNCX_ADAPTIVE_SPIN
+    barrier_ptr->tx_barrier_spin_budget = TX_SYNCX_SPIN_MIN;
+#endif
     UINT ret = tx_mutex_create(&(barrier_ptr->tx_barrier_mtx_counter), name_ptr, inherit);
     
     if (TX_SUCCESS == ret)
@@ -43,6 +47,7 @@ UINT tx_barrier_reset(TX_BARRIER* barrier_ptr)
 
     if (TX_SUCCESS == ret)
     {
+        TX_SYNCX_TRACE(TX_SYNCX_TRACE_BARRIER_RESET, barrier_ptr, barrier_ptr->tx_barrier_counter, barrier_ptr->tx_barrier_raise_count, 0);
         barrier_ptr->tx_barrier_counter = 0;        
         while (_tx_semaphore_abort_suspended(&(barrier_ptr->tx_barrier_sem_raise)))
             ;
@@ -61,7 +66,15 @@ UINT tx_barrier_wait(TX_BARRIER* barrier_ptr, ULONG wait_option)
         UINT count = ++(barrier_ptr->tx_barrier_counter);
         UINT wait = count != barrier_ptr->tx_barrier_raise_count;
 
+        TX_SYNCX_TRACE(wait ? TX_SYNCX_TRACE_BARRIER_ARRIVE : TX_SYNCX_TRACE_BARRIER_RELEASE, barrier_ptr, count, barrier_ptr->tx_barrier_raise_count, 0);
         tx_mutex_put(&(barrier_ptr->tx_barrier_mtx_counter));
+#ifdef TX_SYNCX_ADAPTIVE_SPIN
+        /* Only spin when the missing threads can all be running on the other cores */
+        if (wait && TX_NO_WAIT != wait_option && barrier_ptr->tx_barrier_raise_count - count < TX_THREAD_SMP_MAX_CORES)
+        {
+            wait = TX_SUCCESS != _tx_syncx_spin_get(&(barrier_ptr->tx_barrier_sem_raise), TX_NULL, &(barrier_ptr->tx_barrier_spin_budget));
+        }
+#endif
         ret = wait
             ? tx_semaphore_get(&(barrier_ptr->tx_barrier_sem_raise), wait_option)
             : TX_SUCCESS;
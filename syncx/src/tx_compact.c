@@ -0,0 +1,319 @@
+#include "tx_compact.h"
+
+/* R/w lock state: writer flag and readers count */
+#define TX_RWLOCK_COMPACT_WRITER    0x40000000UL
+#define TX_RWLOCK_COMPACT_READERS   0x3FFFFFFFUL
+
+/* Barrier state: raised flag, reset generation and waiters count */
+#define TX_BARRIER_COMPACT_RAISED   0x40000000UL
+#define TX_BARRIER_COMPACT_GEN      0x3FFF0000UL
+#define TX_BARRIER_COMPACT_GEN_ONE  0x00010000UL
+#define TX_BARRIER_COMPACT_COUNT    0x0000FFFFUL
+
+/* Waiter record, lives on the stack of the waiting thread while it is linked to a compact object */
+typedef struct TX_COMPACT_WAITER_STRUCT
+{
+    UINT tx_compact_waiter_status;
+    UINT tx_compact_waiter_linked;
+    TX_SEMAPHORE tx_compact_waiter_sem;
+    struct TX_COMPACT_WAITER_STRUCT* tx_compact_waiter_next;
+} TX_COMPACT_WAITER;
+
+static ULONG _tx_compact_remaining(ULONG start, ULONG wait_option)
+{
+    if (TX_WAIT_FOREVER != wait_option)
+    {
+        ULONG elapsed = tx_time_get() - start;
+
+        wait_option = elapsed >= wait_option ? TX_NO_WAIT : wait_option - elapsed;
+    }
+    return wait_option;
+}
+
+/* Detach all the waiters of an object. Must be called with interrupts disabled */
+static TX_COMPACT_WAITER* _tx_compact_detach(TX_COMPACT_WAITER** waiters_ptr)
+{
+    TX_COMPACT_WAITER* waiters = *waiters_ptr;
+
+    for (TX_COMPACT_WAITER* waiter = waiters; waiter; waiter = waiter->tx_compact_waiter_next)
+    {
+        waiter->tx_compact_waiter_linked = TX_FALSE;
+    }
+    *waiters_ptr = TX_NULL;
+    return waiters;
+}
+
+/* Resume detached waiters, they check the object again unless status is an error */
+static UINT _tx_compact_resume(TX_COMPACT_WAITER* waiter, UINT status)
+{
+    UINT ret = TX_SUCCESS;
+
+    while (waiter)
+    {
+        /* Waiter may return and release its record as soon as its semaphore is put, read next first */
+        TX_COMPACT_WAITER* next = waiter->tx_compact_waiter_next;
+
+        waiter->tx_compact_waiter_status = status;
+        if (TX_SUCCESS != tx_semaphore_put(&(waiter->tx_compact_waiter_sem)))
+        {
+            ret = TX_SEMAPHORE_ERROR;
+        }
+        waiter = next;
+    }
+    return ret;
+}
+
+static UINT _tx_compact_unlink(TX_COMPACT_WAITER** waiters_ptr, TX_COMPACT_WAITER* waiter)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    UINT linked = waiter->tx_compact_waiter_linked;
+
+    /* Only a linked waiter may touch the object: once detached, the object may be deleted */
+    if (linked)
+    {
+        while (*waiters_ptr != waiter)
+        {
+            waiters_ptr = &((*waiters_ptr)->tx_compact_waiter_next);
+        }
+        *waiters_ptr = waiter->tx_compact_waiter_next;
+        waiter->tx_compact_waiter_linked = TX_FALSE;
+    }
+    tx_interrupt_control(old);
+    return linked;
+}
+
+/*
+* Attempt functions are called with interrupts disabled, they return TX_NOT_AVAILABLE to keep waiting.
+* A failed attempt links the waiter within the same lockout, releases detach and resume linked waiters only:
+* no release can be missed between the attempt and the suspension, which happens with interrupts enabled.
+* The waiter semaphore is created on the stack of the caller once it has to suspend.
+*/
+static UINT _tx_compact_wait(TX_COMPACT_WAITER** waiters_ptr, ULONG* state_ptr, UINT(*attempt)(ULONG*, ULONG), ULONG param, ULONG wait_option, UINT timeout_status)
+{
+    TX_COMPACT_WAITER waiter;
+    ULONG start = tx_time_get();
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    UINT ret = attempt(state_ptr, param);
+
+    tx_interrupt_control(old);
+    if (TX_NOT_AVAILABLE != ret || TX_NO_WAIT == wait_option)
+    {
+        return TX_NOT_AVAILABLE == ret ? timeout_status : ret;
+    }
+    ret = tx_semaphore_create(&(waiter.tx_compact_waiter_sem), TX_NULL, 0);
+    if (TX_SUCCESS != ret)
+    {
+        return ret;
+    }
+    while (TX_SUCCESS == ret)
+    {
+        old = tx_interrupt_control(TX_INT_DISABLE);
+        ret = attempt(state_ptr, param);
+        if (TX_NOT_AVAILABLE == ret)
+        {
+            waiter.tx_compact_waiter_status = TX_SUCCESS;
+            waiter.tx_compact_waiter_linked = TX_TRUE;
+            waiter.tx_compact_waiter_next = *waiters_ptr;
+            *waiters_ptr = &waiter;
+        }
+        tx_interrupt_control(old);
+        if (TX_NOT_AVAILABLE != ret)
+        {
+            break;
+        }
+
+        ret = tx_semaphore_get(&(waiter.tx_compact_waiter_sem), _tx_compact_remaining(start, wait_option));
+        if (TX_SUCCESS == ret || !_tx_compact_unlink(waiters_ptr, &waiter))
+        {
+            /* Already detached by a release or a deletion: its put is pending, the record must outlive it */
+            while (TX_SUCCESS != ret)
+            {
+                ret = tx_semaphore_get(&(waiter.tx_compact_waiter_sem), TX_WAIT_FOREVER);
+            }
+            ret = waiter.tx_compact_waiter_status;
+        }
+        else if (TX_NO_INSTANCE == ret)
+        {
+            ret = TX_NOT_AVAILABLE;
+        }
+    }
+    tx_semaphore_delete(&(waiter.tx_compact_waiter_sem));
+    return TX_NOT_AVAILABLE == ret ? timeout_status : ret;
+}
+
+/****************************************************/
+/* R/W lock                                         */
+/****************************************************/
+
+UINT tx_rwlock_compact_create(TX_RWLOCK_COMPACT* rwlock_ptr)
+{
+    if (TX_NULL == rwlock_ptr)
+    {
+        return TX_PTR_ERROR;
+    }
+    rwlock_ptr->tx_rwlock_compact_state = 0;
+    rwlock_ptr->tx_rwlock_compact_waiters = TX_NULL;
+    return TX_SUCCESS;
+}
+
+UINT tx_rwlock_compact_delete(TX_RWLOCK_COMPACT* rwlock_ptr)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    TX_COMPACT_WAITER* waiters = _tx_compact_detach(&(rwlock_ptr->tx_rwlock_compact_waiters));
+
+    tx_interrupt_control(old);
+    _tx_compact_resume(waiters, TX_DELETED);
+    return TX_SUCCESS;
+}
+
+static UINT _tx_rwlock_compact_rattempt(ULONG* state_ptr, ULONG param)
+{
+    TX_PARAMETER_NOT_USED(param);
+    if (*state_ptr & TX_RWLOCK_COMPACT_WRITER)
+    {
+        return TX_NOT_AVAILABLE;
+    }
+    (*state_ptr)++;
+    return TX_SUCCESS;
+}
+
+static UINT _tx_rwlock_compact_wattempt(ULONG* state_ptr, ULONG param)
+{
+    TX_PARAMETER_NOT_USED(param);
+    if (*state_ptr)
+    {
+        return TX_NOT_AVAILABLE;
+    }
+    *state_ptr = TX_RWLOCK_COMPACT_WRITER;
+    return TX_SUCCESS;
+}
+
+UINT tx_rwlock_compact_rget(TX_RWLOCK_COMPACT* rwlock_ptr, ULONG wait_option)
+{
+    return _tx_compact_wait(&(rwlock_ptr->tx_rwlock_compact_waiters), &(rwlock_ptr->tx_rwlock_compact_state),
+        _tx_rwlock_compact_rattempt, 0, wait_option, TX_NOT_AVAILABLE);
+}
+
+UINT tx_rwlock_compact_rput(TX_RWLOCK_COMPACT* rwlock_ptr)
+{
+    TX_COMPACT_WAITER* waiters = TX_NULL;
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+
+    if (!(rwlock_ptr->tx_rwlock_compact_state & TX_RWLOCK_COMPACT_READERS))
+    {
+        tx_interrupt_control(old);
+        return TX_NOT_OWNED;
+    }
+    if (!--(rwlock_ptr->tx_rwlock_compact_state))
+    {
+        /* Last reader resumes the waiting writers */
+        waiters = _tx_compact_detach(&(rwlock_ptr->tx_rwlock_compact_waiters));
+    }
+    tx_interrupt_control(old);
+    return _tx_compact_resume(waiters, TX_SUCCESS);
+}
+
+UINT tx_rwlock_compact_wget(TX_RWLOCK_COMPACT* rwlock_ptr, ULONG wait_option)
+{
+    return _tx_compact_wait(&(rwlock_ptr->tx_rwlock_compact_waiters), &(rwlock_ptr->tx_rwlock_compact_state),
+        _tx_rwlock_compact_wattempt, 0, wait_option, TX_NOT_AVAILABLE);
+}
+
+UINT tx_rwlock_compact_wput(TX_RWLOCK_COMPACT* rwlock_ptr)
+{
+    TX_COMPACT_WAITER* waiters;
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+
+    if (!(rwlock_ptr->tx_rwlock_compact_state & TX_RWLOCK_COMPACT_WRITER))
+    {
+        tx_interrupt_control(old);
+        return TX_NOT_OWNED;
+    }
+    rwlock_ptr->tx_rwlock_compact_state = 0;
+    waiters = _tx_compact_detach(&(rwlock_ptr->tx_rwlock_compact_waiters));
+    tx_interrupt_control(old);
+    return _tx_compact_resume(waiters, TX_SUCCESS);
+}
+
+/****************************************************/
+/* Barrier                                          */
+/****************************************************/
+
+UINT tx_barrier_compact_create(TX_BARRIER_COMPACT* barrier_ptr, UINT raise_count)
+{
+    if (TX_NULL == barrier_ptr)
+    {
+        return TX_PTR_ERROR;
+    }
+    if (raise_count > TX_BARRIER_COMPACT_COUNT)
+    {
+        return TX_SIZE_ERROR;
+    }
+    barrier_ptr->tx_barrier_compact_state = 0;
+    barrier_ptr->tx_barrier_compact_raise_count = raise_count;
+    barrier_ptr->tx_barrier_compact_waiters = TX_NULL;
+    return TX_SUCCESS;
+}
+
+UINT tx_barrier_compact_delete(TX_BARRIER_COMPACT* barrier_ptr)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    TX_COMPACT_WAITER* waiters = _tx_compact_detach(&(barrier_ptr->tx_barrier_compact_waiters));
+
+    tx_interrupt_control(old);
+    _tx_compact_resume(waiters, TX_DELETED);
+    return TX_SUCCESS;
+}
+
+static UINT _tx_barrier_compact_attempt(ULONG* state_ptr, ULONG generation)
+{
+    if ((*state_ptr & TX_BARRIER_COMPACT_GEN) != generation)
+    {
+        return TX_WAIT_ABORTED;
+    }
+    return *state_ptr & TX_BARRIER_COMPACT_RAISED
+        ? TX_SUCCESS
+        : TX_NOT_AVAILABLE;
+}
+
+UINT tx_barrier_compact_wait(TX_BARRIER_COMPACT* barrier_ptr, ULONG wait_option)
+{
+    TX_COMPACT_WAITER* waiters = TX_NULL;
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    ULONG state = barrier_ptr->tx_barrier_compact_state;
+    ULONG generation = state & TX_BARRIER_COMPACT_GEN;
+
+    if (!(state & TX_BARRIER_COMPACT_RAISED))
+    {
+        /* Increment waiters count, the last one raises the barrier */
+        if (((state & TX_BARRIER_COMPACT_COUNT) + 1) >= barrier_ptr->tx_barrier_compact_raise_count)
+        {
+            waiters = _tx_compact_detach(&(barrier_ptr->tx_barrier_compact_waiters));
+            state = generation | TX_BARRIER_COMPACT_RAISED;
+        }
+        else
+        {
+            state++;
+        }
+        barrier_ptr->tx_barrier_compact_state = state;
+    }
+    tx_interrupt_control(old);
+
+    if (state & TX_BARRIER_COMPACT_RAISED)
+    {
+        return _tx_compact_resume(waiters, TX_SUCCESS);
+    }
+    return _tx_compact_wait(&(barrier_ptr->tx_barrier_compact_waiters), &(barrier_ptr->tx_barrier_compact_state),
+        _tx_barrier_compact_attempt, generation, wait_option, TX_NO_INSTANCE);
+}
+
+UINT tx_barrier_compact_reset(TX_BARRIER_COMPACT* barrier_ptr)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    TX_COMPACT_WAITER* waiters = _tx_compact_detach(&(barrier_ptr->tx_barrier_compact_waiters));
+
+    /* New generation aborts the waiting threads */
+    barrier_ptr->tx_barrier_compact_state = (barrier_ptr->tx_barrier_compact_state + TX_BARRIER_COMPACT_GEN_ONE) & TX_BARRIER_COMPACT_GEN;
+    tx_interrupt_control(old);
+    return _tx_compact_resume(waiters, TX_SUCCESS);
+}
@@ -0,0 +1,140 @@
+#include "tx_condvar.h"
+
+UINT tx_condvar_create(TX_CONDVAR* condvar_ptr, CHAR* name_ptr)
+{
+    condvar_ptr->tx_condvar_name = name_ptr;
+    condvar_ptr->tx_condvar_waiters = 0;
+    return tx_semaphore_create(&(condvar_ptr->tx_condvar_sem_wake), name_ptr, 0);
+}
+
+UINT tx_condvar_delete(TX_CONDVAR* condvar_ptr)
+{
+    return tx_semaphore_delete(&(condvar_ptr->tx_condvar_sem_wake));
+}
+
+static UINT _tx_condvar_mutex_get(VOID* lock_ptr, ULONG wait_option)
+{
+    return tx_mutex_get((TX_MUTEX*)lock_ptr, wait_option);
+}
+
+static UINT _tx_condvar_mutex_put(VOID* lock_ptr)
+{
+    return tx_mutex_put((TX_MUTEX*)lock_ptr);
+}
+
+static UINT _tx_condvar_rwlock_rget(VOID* lock_ptr, ULONG wait_option)
+{
+    return tx_rwlock_rget((TX_RWLOCK*)lock_ptr, wait_option);
+}
+
+static UINT _tx_condvar_rwlock_rput(VOID* lock_ptr)
+{
+    return tx_rwlock_rput((TX_RWLOCK*)lock_ptr);
+}
+
+static UINT _tx_condvar_rwlock_wget(VOID* lock_ptr, ULONG wait_option)
+{
+    return tx_rwlock_wget((TX_RWLOCK*)lock_ptr, wait_option);
+}
+
+static UINT _tx_condvar_rwlock_wput(VOID* lock_ptr)
+{
+    return tx_rwlock_wput((TX_RWLOCK*)lock_ptr);
+}
+
+static UINT _tx_condvar_withdraw(TX_CONDVAR* condvar_ptr)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    UINT signaled = !condvar_ptr->tx_condvar_waiters;
+
+    if (!signaled)
+    {
+        condvar_ptr->tx_condvar_waiters--;
+    }
+    tx_interrupt_control(old);
+    return signaled;
+}
+
+static UINT _tx_condvar_wait(TX_CONDVAR* condvar_ptr, VOID* lock_ptr, UINT(*lock_get)(VOID*, ULONG), UINT(*lock_put)(VOID*), ULONG wait_option)
+{
+    /* Register as a waiter before releasing the lock, so no signal sent after the release is lost */
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    condvar_ptr->tx_condvar_waiters++;
+    tx_interrupt_control(old);
+
+    UINT ret = lock_put(lock_ptr);
+
+    if (TX_SUCCESS != ret)
+    {
+        if (_tx_condvar_withdraw(condvar_ptr))
+        {
+            /* A signal was already counted for this thread, pass it on */
+            tx_semaphore_put(&(condvar_ptr->tx_condvar_sem_wake));
+        }
+        return ret;
+    }
+    ret = tx_semaphore_get(&(condvar_ptr->tx_condvar_sem_wake), wait_option);
+    if (TX_DELETED == ret)
+    {
+        return ret;
+    }
+    if (TX_SUCCESS != ret && _tx_condvar_withdraw(condvar_ptr))
+    {
+        /* Signal raced with the timeout: its wake-up is or will be put for this thread, take it and report the signal */
+        ret = tx_semaphore_get(&(condvar_ptr->tx_condvar_sem_wake), TX_WAIT_FOREVER);
+        if (TX_DELETED == ret)
+        {
+            return ret;
+        }
+    }
+
+    /* Failing to obtain the lock again is reported first: the caller does not own it */
+    UINT get = lock_get(lock_ptr, TX_WAIT_FOREVER);
+
+    return TX_SUCCESS != get ? get : ret;
+}
+
+UINT tx_condvar_wait(TX_CONDVAR* condvar_ptr, TX_MUTEX* mutex_ptr, ULONG wait_option)
+{
+    return _tx_condvar_wait(condvar_ptr, mutex_ptr, _tx_condvar_mutex_get, _tx_condvar_mutex_put, wait_option);
+}
+
+UINT tx_condvar_rwait(TX_CONDVAR* condvar_ptr, TX_RWLOCK* rwlock_ptr, ULONG wait_option)
+{
+    return _tx_condvar_wait(condvar_ptr, rwlock_ptr, _tx_condvar_rwlock_rget, _tx_condvar_rwlock_rput, wait_option);
+}
+
+UINT tx_condvar_wwait(TX_CONDVAR* condvar_ptr, TX_RWLOCK* rwlock_ptr, ULONG wait_option)
+{
+    return _tx_condvar_wait(condvar_ptr, rwlock_ptr, _tx_condvar_rwlock_wget, _tx_condvar_rwlock_wput, wait_option);
+}
+
+UINT tx_condvar_signal(TX_CONDVAR* condvar_ptr)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    UINT wake = condvar_ptr->tx_condvar_waiters != 0;
+
+    if (wake)
+    {
+        condvar_ptr->tx_condvar_waiters--;
+    }
+    tx_interrupt_control(old);
+    return wake
+        ? tx_semaphore_put(&(condvar_ptr->tx_condvar_sem_wake))
+        : TX_SUCCESS;
+}
+
+UINT tx_condvar_broadcast(TX_CONDVAR* condvar_ptr)
+{
+    UINT ret = TX_SUCCESS;
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    ULONG wake = condvar_ptr->tx_condvar_waiters;
+
+    condvar_ptr->tx_condvar_waiters = 0;
+    tx_interrupt_control(old);
+    while (wake-- && TX_SUCCESS == ret)
+    {
+        ret = tx_semaphore_put(&(condvar_ptr->tx_condvar_sem_wake));
+    }
+    return ret;
+}
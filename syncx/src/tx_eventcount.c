@@ -0,0 +1,147 @@
+#include "tx_eventcount.h"
+
+#define _TX_EVENTCOUNT_REACHED(counter, target)  ((LONG)((counter) - (target)) >= 0)
+
+UINT tx_eventcount_create(TX_EVENTCOUNT* eventcount_ptr, CHAR* name_ptr, ULONG initial_count)
+{
+    eventcount_ptr->tx_eventcount_name = name_ptr;
+    eventcount_ptr->tx_eventcount_counter = initial_count;
+    eventcount_ptr->tx_eventcount_waiters = TX_NULL;
+    return TX_SUCCESS;
+}
+
+static UINT _tx_eventcount_resume(TX_EVENTCOUNT_WAITER* waiter, UINT status)
+{
+    UINT ret = TX_SUCCESS;
+
+    while (waiter)
+    {
+        /* Waiter returns and releases its record as soon as its semaphore is put, read next first */
+        TX_EVENTCOUNT_WAITER* next = waiter->tx_eventcount_waiter_next;
+
+        waiter->tx_eventcount_waiter_status = status;
+        if (TX_SUCCESS != tx_semaphore_put(&(waiter->tx_eventcount_waiter_sem)))
+        {
+            ret = TX_SEMAPHORE_ERROR;
+        }
+        waiter = next;
+    }
+    return ret;
+}
+
+UINT tx_eventcount_delete(TX_EVENTCOUNT* eventcount_ptr)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    TX_EVENTCOUNT_WAITER* waiters = eventcount_ptr->tx_eventcount_waiters;
+
+    /* Detached waiters never access the event count again, it can be reused once they are resumed */
+    for (TX_EVENTCOUNT_WAITER* waiter = waiters; waiter; waiter = waiter->tx_eventcount_waiter_next)
+    {
+        waiter->tx_eventcount_waiter_linked = TX_FALSE;
+    }
+    eventcount_ptr->tx_eventcount_waiters = TX_NULL;
+    tx_interrupt_control(old);
+    _tx_eventcount_resume(waiters, TX_DELETED);
+    return TX_SUCCESS;
+}
+
+UINT tx_eventcount_advance(TX_EVENTCOUNT* eventcount_ptr, ULONG increment)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    ULONG counter = (eventcount_ptr->tx_eventcount_counter += increment);
+    TX_EVENTCOUNT_WAITER* reached = eventcount_ptr->tx_eventcount_waiters;
+    TX_EVENTCOUNT_WAITER** link = &(eventcount_ptr->tx_eventcount_waiters);
+
+    /* Waiters are sorted by target, detach the ones reached */
+    while (*link && _TX_EVENTCOUNT_REACHED(counter, (*link)->tx_eventcount_waiter_target))
+    {
+        (*link)->tx_eventcount_waiter_linked = TX_FALSE;
+        link = &((*link)->tx_eventcount_waiter_next);
+    }
+    if (link != &(eventcount_ptr->tx_eventcount_waiters))
+    {
+        eventcount_ptr->tx_eventcount_waiters = *link;
+        *link = TX_NULL;
+    }
+    else
+    {
+        reached = TX_NULL;
+    }
+    tx_interrupt_control(old);
+    return _tx_eventcount_resume(reached, TX_SUCCESS);
+}
+
+static UINT _tx_eventcount_unlink(TX_EVENTCOUNT* eventcount_ptr, TX_EVENTCOUNT_WAITER* waiter)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    UINT linked = waiter->tx_eventcount_waiter_linked;
+
+    /* Only a linked waiter may touch the event count: once detached, the event count may be deleted */
+    if (linked)
+    {
+        TX_EVENTCOUNT_WAITER** link = &(eventcount_ptr->tx_eventcount_waiters);
+
+        while (*link != waiter)
+        {
+            link = &((*link)->tx_eventcount_waiter_next);
+        }
+        *link = waiter->tx_eventcount_waiter_next;
+        waiter->tx_eventcount_waiter_linked = TX_FALSE;
+    }
+    tx_interrupt_control(old);
+    return linked;
+}
+
+UINT tx_eventcount_wait(TX_EVENTCOUNT* eventcount_ptr, ULONG target, ULONG wait_option)
+{
+    TX_EVENTCOUNT_WAITER waiter;
+    TX_EVENTCOUNT_WAITER** link;
+    UINT old, ret;
+
+    if (_TX_EVENTCOUNT_REACHED(eventcount_ptr->tx_eventcount_counter, target))
+    {
+        return TX_SUCCESS;
+    }
+    if (TX_NO_WAIT == wait_option)
+    {
+        return TX_NO_INSTANCE;
+    }
+    ret = tx_semaphore_create(&(waiter.tx_eventcount_waiter_sem), eventcount_ptr->tx_eventcount_name, 0);
+    if (TX_SUCCESS != ret)
+    {
+        return ret;
+    }
+
+    /* Check again and insert in target order, the counter may have moved meanwhile */
+    old = tx_interrupt_control(TX_INT_DISABLE);
+    if (_TX_EVENTCOUNT_REACHED(eventcount_ptr->tx_eventcount_counter, target))
+    {
+        tx_interrupt_control(old);
+        tx_semaphore_delete(&(waiter.tx_eventcount_waiter_sem));
+        return TX_SUCCESS;
+    }
+    waiter.tx_eventcount_waiter_target = target;
+    waiter.tx_eventcount_waiter_status = TX_SUCCESS;
+    waiter.tx_eventcount_waiter_linked = TX_TRUE;
+    link = &(eventcount_ptr->tx_eventcount_waiters);
+    while (*link && _TX_EVENTCOUNT_REACHED(target, (*link)->tx_eventcount_waiter_target))
+    {
+        link = &((*link)->tx_eventcount_waiter_next);
+    }
+    waiter.tx_eventcount_waiter_next = *link;
+    *link = &waiter;
+    tx_interrupt_control(old);
+
+    ret = tx_semaphore_get(&(waiter.tx_eventcount_waiter_sem), wait_option);
+    if (TX_SUCCESS == ret || !_tx_eventcount_unlink(eventcount_ptr, &waiter))
+    {
+        /* Already detached by a producer or a deletion: its put is pending, the record must outlive it */
+        while (TX_SUCCESS != ret)
+        {
+            ret = tx_semaphore_get(&(waiter.tx_eventcount_waiter_sem), TX_WAIT_FOREVER);
+        }
+        ret = waiter.tx_eventcount_waiter_status;
+    }
+    tx_semaphore_delete(&(waiter.tx_eventcount_waiter_sem));
+    return ret;
+}
@@ -0,0 +1,59 @@
+#include "tx_latch.h"
+
+#define TX_LATCH_OPEN   0x1
+
+UINT tx_latch_create(TX_LATCH* latch_ptr, CHAR* name_ptr, ULONG count)
+{
+    latch_ptr->tx_latch_name = name_ptr;
+    latch_ptr->tx_latch_count = count;
+    UINT ret = tx_event_flags_create(&(latch_ptr->tx_latch_evt_open), name_ptr);
+
+    if (TX_SUCCESS == ret && !count)
+    {
+        ret = tx_event_flags_set(&(latch_ptr->tx_latch_evt_open), TX_LATCH_OPEN, TX_OR);
+    }
+    return ret;
+}
+
+UINT tx_latch_delete(TX_LATCH* latch_ptr)
+{
+    return tx_event_flags_delete(&(latch_ptr->tx_latch_evt_open));
+}
+
+UINT tx_latch_count_down(TX_LATCH* latch_ptr, ULONG count)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    UINT open = latch_ptr->tx_latch_count && latch_ptr->tx_latch_count <= count;
+
+    latch_ptr->tx_latch_count = latch_ptr->tx_latch_count > count
+        ? latch_ptr->tx_latch_count - count
+        : 0;
+    tx_interrupt_control(old);
+
+    /* Only the count down reaching zero opens the latch, resuming every waiter at once */
+    return open
+        ? tx_event_flags_set(&(latch_ptr->tx_latch_evt_open), TX_LATCH_OPEN, TX_OR)
+        : TX_SUCCESS;
+}
+
+UINT tx_latch_wait(TX_LATCH* latch_ptr, ULONG wait_option)
+{
+    ULONG actual;
+
+    return tx_event_flags_get(&(latch_ptr->tx_latch_evt_open), TX_LATCH_OPEN, TX_OR, &actual, wait_option);
+}
+
+UINT tx_latch_reset(TX_LATCH* latch_ptr, ULONG count)
+{
+    UINT ret = tx_event_flags_set(&(latch_ptr->tx_latch_evt_open), ~(ULONG)TX_LATCH_OPEN, TX_AND);
+
+    if (TX_SUCCESS == ret)
+    {
+        latch_ptr->tx_latch_count = count;
+        if (!count)
+        {
+            ret = tx_event_flags_set(&(latch_ptr->tx_latch_evt_open), TX_LATCH_OPEN, TX_OR);
+        }
+    }
+    return ret;
+}
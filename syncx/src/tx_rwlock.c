@@ -1,9 +1,42 @@
 #include "tx_rwlock.h"
+#include "tx_syncx_trace.h"
+#include "tx_thread.h"
+
+#define TX_RWLOCK_NOT_BOOSTED   TX_MAX_PRIORITIES
+
+/* Write semaphore is first tried without waiting to trace or inherit before blocking */
+#if defined(TX_ENABLE_EVENT_TRACE)
+#define _TX_RWLOCK_TRY_FIRST(rwlock_ptr)    TX_TRUE
+#elif !defined(TX_RWLOCK_DISABLE_INHERIT)
+#define _TX_RWLOCK_TRY_FIRST(rwlock_ptr)    (TX_INHERIT == (rwlock_ptr)->tx_rwlock_inherit)
+#else
+#define _TX_RWLOCK_TRY_FIRST(rwlock_ptr)    TX_FALSE
+#endif
 
 UINT tx_rwlock_create(TX_RWLOCK* rwlock_ptr, CHAR* name_ptr, UINT inherit)
 {
     rwlock_ptr->tx_rwlock_name = name_ptr;
     rwlock_ptr->tx_rwlock_rcounter = 0;
+#ifndef TX_RWLOCK_DISABLE_INHERIT
+    rwlock_ptr->tx_rwlock_inherit = inherit;
+    for (UINT i = 0; i < TX_RWLOCK_MAX_READERS; i++)
+    {
+        rwlock_ptr->tx_rwlock_readers[i].tx_rwlock_reader_thread = TX_NULL;
+        rwlock_ptr->tx_rwlock_readers[i].tx_rwlock_reader_priority = TX_RWLOCK_NOT_BOOSTED;
+    }
+    rwlock_ptr->tx_rwlock_untracked = 0;
+    rwlock_ptr->tx_rwlock_writers_pending = 0;
+    rwlock_ptr->tx_rwlock_writers_priority = TX_RWLOCK_NOT_BOOSTED;
+#endif
+#ifdef TX_RWLOCK_ENABLE_ASYNC
+    rwlock_ptr->tx_rwlock_async_first = rwlock_ptr->tx_rwlock_async_count = 0;
+    rwlock_ptr->tx_rwlock_async_granting = rwlock_ptr->tx_rwlock_async_regrant = TX_FALSE;
+    rwlock_ptr->tx_rwlock_async_stalled = TX_FALSE;
+#endif
+#ifdef TX_RWLOCK_SPIN
+    rwlock_ptr->tx_rwlock_writer = TX_NULL;
+    rwlock_ptr->tx_rwlock_spin_budget = TX_SYNCX_SPIN_MIN;
+#endif
     UINT ret = tx_mutex_create(&(rwlock_ptr->tx_rwlock_mtx_rcounter), name_ptr, inherit);
 
     if (TX_SUCCESS == ret)
@@ -19,6 +52,357 @@ UINT tx_rwlock_delete(TX_RWLOCK* rwlock_ptr)
     return tx_semaphore_delete(&(rwlock_ptr->tx_rwlock_sem_write));
 }
 
+static ULONG _tx_rwlock_remaining(ULONG start, ULONG wait_option)
+{
+    if (TX_WAIT_FOREVER != wait_option)
+    {
+        ULONG elapsed = tx_time_get() - start;
+
+        wait_option = elapsed >= wait_option ? TX_NO_WAIT : wait_option - elapsed;
+    }
+    return wait_option;
+}
+
+#ifdef TX_RWLOCK_SPIN
+
+/* Spin on the write semaphore while it is owned by a running writer */
+static UINT _tx_rwlock_spin(TX_RWLOCK* rwlock_ptr, ULONG wait_option)
+{
+    TX_THREAD* writer = rwlock_ptr->tx_rwlock_writer;
+
+    return TX_NO_WAIT != wait_option && writer && writer != tx_thread_identify()
+        ? _tx_syncx_spin_get(&(rwlock_ptr->tx_rwlock_sem_write), writer, &(rwlock_ptr->tx_rwlock_spin_budget))
+        : TX_NO_INSTANCE;
+}
+
+#endif
+
+#ifndef TX_RWLOCK_DISABLE_INHERIT
+
+static UINT _tx_rwlock_priority(TX_THREAD* thread_ptr)
+{
+    UINT priority = TX_RWLOCK_NOT_BOOSTED;
+
+    tx_thread_info_get(thread_ptr, TX_NULL, TX_NULL, TX_NULL, &priority, TX_NULL, TX_NULL, TX_NULL, TX_NULL);
+    return priority;
+}
+
+/* Raise a recorded reader to a writer priority. Must be called with the reader counter mutex owned */
+static VOID _tx_rwlock_reader_boost(TX_RWLOCK_READER* reader, UINT priority)
+{
+    TX_THREAD* thread = reader->tx_rwlock_reader_thread;
+    UINT current = TX_RWLOCK_NOT_BOOSTED;
+    UINT threshold = TX_RWLOCK_NOT_BOOSTED;
+    UINT old;
+
+    tx_thread_info_get(thread, TX_NULL, TX_NULL, TX_NULL, &current, &threshold, TX_NULL, TX_NULL, TX_NULL);
+    if (current > priority)
+    {
+        /* Priority change also resets the preemption threshold, keep a lower one */
+        tx_thread_priority_change(thread, priority, &old);
+        if (threshold < priority)
+        {
+            tx_thread_preemption_change(thread, threshold, &old);
+        }
+        if (TX_RWLOCK_NOT_BOOSTED == reader->tx_rwlock_reader_priority)
+        {
+            reader->tx_rwlock_reader_priority = current;
+            reader->tx_rwlock_reader_threshold = threshold;
+        }
+        reader->tx_rwlock_reader_boost = priority;
+    }
+}
+
+/* Must be called with the reader counter mutex owned */
+static VOID _tx_rwlock_reader_add(TX_RWLOCK* rwlock_ptr, TX_THREAD* thread_ptr)
+{
+    for (UINT i = 0; i < TX_RWLOCK_MAX_READERS; i++)
+    {
+        TX_RWLOCK_READER* reader = rwlock_ptr->tx_rwlock_readers + i;
+
+        if (TX_NULL == reader->tx_rwlock_reader_thread)
+        {
+            UINT priority = rwlock_ptr->tx_rwlock_writers_priority;
+
+            reader->tx_rwlock_reader_thread = thread_ptr;
+            reader->tx_rwlock_reader_priority = TX_RWLOCK_NOT_BOOSTED;
+
+            /* Admitted while a writer waits: the writer now waits for this reader too */
+            if (TX_RWLOCK_NOT_BOOSTED != priority)
+            {
+                _tx_rwlock_reader_boost(reader, priority);
+            }
+            return;
+        }
+    }
+
+    /* No record left: this reader keeps its priority while a writer waits */
+    rwlock_ptr->tx_rwlock_untracked++;
+}
+
+/* Must be called with the reader counter mutex owned */
+static VOID _tx_rwlock_reader_remove(TX_RWLOCK* rwlock_ptr, TX_THREAD* thread_ptr)
+{
+    for (UINT i = 0; i < TX_RWLOCK_MAX_READERS; i++)
+    {
+        TX_RWLOCK_READER* reader = rwlock_ptr->tx_rwlock_readers + i;
+
+        if (thread_ptr == reader->tx_rwlock_reader_thread)
+        {
+            /* Restore the priority and preemption threshold the reader had before being boosted by a writer,
+               unless its priority was changed meanwhile by the application or another inheritance */
+            if (TX_RWLOCK_NOT_BOOSTED != reader->tx_rwlock_reader_priority && reader->tx_rwlock_reader_boost == _tx_rwlock_priority(thread_ptr))
+            {
+                UINT old;
+
+                tx_thread_priority_change(thread_ptr, reader->tx_rwlock_reader_priority, &old);
+                if (reader->tx_rwlock_reader_threshold < reader->tx_rwlock_reader_priority)
+                {
+                    tx_thread_preemption_change(thread_ptr, reader->tx_rwlock_reader_threshold, &old);
+                }
+            }
+            reader->tx_rwlock_reader_thread = TX_NULL;
+            reader->tx_rwlock_reader_priority = TX_RWLOCK_NOT_BOOSTED;
+            break;
+        }
+    }
+}
+
+/* Record a pending writer priority, then raise current readers to it if the reader counter mutex is obtained within the wait option */
+static UINT _tx_rwlock_readers_boost(TX_RWLOCK* rwlock_ptr, ULONG wait_option)
+{
+    TX_THREAD* writer = tx_thread_identify();
+    UINT priority = _tx_rwlock_priority(writer);
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    UINT ret;
+
+    rwlock_ptr->tx_rwlock_writers_pending++;
+    if (priority < rwlock_ptr->tx_rwlock_writers_priority)
+    {
+        rwlock_ptr->tx_rwlock_writers_priority = priority;
+    }
+    tx_interrupt_control(old);
+
+    ret = tx_mutex_get(&(rwlock_ptr->tx_rwlock_mtx_rcounter), wait_option);
+    if (TX_SUCCESS == ret)
+    {
+        for (UINT i = 0; i < TX_RWLOCK_MAX_READERS; i++)
+        {
+            TX_RWLOCK_READER* reader = rwlock_ptr->tx_rwlock_readers + i;
+            TX_THREAD* thread = reader->tx_rwlock_reader_thread;
+
+            if (thread && thread != writer)
+            {
+                _tx_rwlock_reader_boost(reader, priority);
+            }
+        }
+        ret = tx_mutex_put(&(rwlock_ptr->tx_rwlock_mtx_rcounter));
+    }
+    return ret;
+}
+
+/* Forget a writer recorded by _tx_rwlock_readers_boost once it stops waiting, the reader counter mutex may be owned by a reader waiting for it */
+static VOID _tx_rwlock_readers_unboost(TX_RWLOCK* rwlock_ptr)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+
+    if (!--(rwlock_ptr->tx_rwlock_writers_pending))
+    {
+        rwlock_ptr->tx_rwlock_writers_priority = TX_RWLOCK_NOT_BOOSTED;
+    }
+    tx_interrupt_control(old);
+}
+
+#endif
+
+#ifdef TX_RWLOCK_ENABLE_ASYNC
+
+/* Nonzero in ISRs and during initialization, where tx_thread_identify returns the interrupted thread or TX_NULL */
+#ifndef TX_THREAD_GET_SYSTEM_STATE
+#define TX_THREAD_GET_SYSTEM_STATE()    _tx_thread_system_state
+#endif
+
+static UINT _tx_rwlock_async_send(TX_RWLOCK_ASYNC* request)
+{
+    UINT ret = tx_queue_send(request->tx_rwlock_async_taskq, &(request->tx_rwlock_async_task), TX_NO_WAIT);
+
+    TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_SEND, request->tx_rwlock_async_taskq, request->tx_rwlock_async_task.task_entry_function, request->tx_rwlock_async_task.task_input, ret);
+    return ret;
+}
+
+/* Grant write access to a request, its task is sent once access is obtained and access is given back if it cannot be */
+static UINT _tx_rwlock_async_wgrant(TX_RWLOCK* rwlock_ptr, TX_RWLOCK_ASYNC* request, UINT owned)
+{
+    UINT ret = owned ? TX_SUCCESS : tx_semaphore_get(&(rwlock_ptr->tx_rwlock_sem_write), TX_NO_WAIT);
+
+    if (TX_SUCCESS == ret)
+    {
+        ret = _tx_rwlock_async_send(request);
+        if (TX_SUCCESS == ret)
+        {
+            TX_SYNCX_TRACE(TX_SYNCX_TRACE_RWLOCK_WGET, rwlock_ptr, 0, 0, 0);
+        }
+        else if (!owned)
+        {
+            tx_semaphore_put(&(rwlock_ptr->tx_rwlock_sem_write));
+        }
+    }
+    return ret;
+}
+
+/* Grant read access to a request: the reader is not recorded for inheritance as its task is not running yet.
+   When the mutex is owned, its owner grants again once it releases it */
+static UINT _tx_rwlock_async_rgrant(TX_RWLOCK* rwlock_ptr, TX_RWLOCK_ASYNC* request, UINT owned)
+{
+    UINT ret = tx_mutex_get(&(rwlock_ptr->tx_rwlock_mtx_rcounter), TX_NO_WAIT);
+
+    if (TX_SUCCESS == ret)
+    {
+        UINT taken = !owned && !rwlock_ptr->tx_rwlock_rcounter;
+
+        if (taken)
+        {
+            ret = tx_semaphore_get(&(rwlock_ptr->tx_rwlock_sem_write), TX_NO_WAIT);
+        }
+        if (TX_SUCCESS == ret)
+        {
+            /* Counted after the send: a task releasing its read access meanwhile waits for the mutex */
+            ret = _tx_rwlock_async_send(request);
+            if (TX_SUCCESS == ret)
+            {
+                rwlock_ptr->tx_rwlock_rcounter++;
+                TX_SYNCX_TRACE(TX_SYNCX_TRACE_RWLOCK_RGET, rwlock_ptr, rwlock_ptr->tx_rwlock_rcounter, 0, 0);
+            }
+            else if (taken)
+            {
+                tx_semaphore_put(&(rwlock_ptr->tx_rwlock_sem_write));
+            }
+        }
+        tx_mutex_put(&(rwlock_ptr->tx_rwlock_mtx_rcounter));
+    }
+    return ret;
+}
+
+/*
+* Grant pending asynchronous accesses in request order, until one is not available or its task queue is full.
+* A full task queue is recorded as a stall, reported to requesters and flushers.
+* With owned, the caller owns the write semaphore and hands it over to the first request instead of releasing it,
+* so that threads suspended on the semaphore do not starve pending requests. It is released if no request takes it.
+*/
+static VOID _tx_rwlock_async_grant(TX_RWLOCK* rwlock_ptr, UINT owned)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    UINT again;
+
+    /* A single thread grants at a time, others make it check again */
+    if (rwlock_ptr->tx_rwlock_async_granting)
+    {
+        rwlock_ptr->tx_rwlock_async_regrant = TX_TRUE;
+        tx_interrupt_control(old);
+        if (owned)
+        {
+            tx_semaphore_put(&(rwlock_ptr->tx_rwlock_sem_write));
+        }
+        return;
+    }
+    rwlock_ptr->tx_rwlock_async_granting = TX_TRUE;
+    tx_interrupt_control(old);
+    do
+    {
+        rwlock_ptr->tx_rwlock_async_regrant = TX_FALSE;
+        rwlock_ptr->tx_rwlock_async_stalled = TX_FALSE;
+        while (rwlock_ptr->tx_rwlock_async_count)
+        {
+            /* Only the granting thread removes requests, appending ones never move the first */
+            TX_RWLOCK_ASYNC* request = rwlock_ptr->tx_rwlock_async + rwlock_ptr->tx_rwlock_async_first;
+            UINT ret = request->tx_rwlock_async_write
+                ? _tx_rwlock_async_wgrant(rwlock_ptr, request, owned)
+                : _tx_rwlock_async_rgrant(rwlock_ptr, request, owned);
+
+            if (TX_SUCCESS != ret)
+            {
+                /* Access not available is granted on release, a full task queue needs a flush */
+                rwlock_ptr->tx_rwlock_async_stalled = TX_QUEUE_FULL == ret;
+                break;
+            }
+            owned = TX_FALSE;
+            old = tx_interrupt_control(TX_INT_DISABLE);
+            rwlock_ptr->tx_rwlock_async_first = (rwlock_ptr->tx_rwlock_async_first + 1) % TX_RWLOCK_MAX_ASYNC;
+            rwlock_ptr->tx_rwlock_async_count--;
+            tx_interrupt_control(old);
+        }
+        if (owned)
+        {
+            /* First request cannot take over, release as usual */
+            owned = TX_FALSE;
+            tx_semaphore_put(&(rwlock_ptr->tx_rwlock_sem_write));
+        }
+        old = tx_interrupt_control(TX_INT_DISABLE);
+        again = rwlock_ptr->tx_rwlock_async_regrant;
+        if (!again)
+        {
+            rwlock_ptr->tx_rwlock_async_granting = TX_FALSE;
+        }
+        tx_interrupt_control(old);
+    } while (again);
+}
+
+static UINT _tx_rwlock_async_request(TX_RWLOCK* rwlock_ptr, UINT write, TX_TASKQ* taskq_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input, UINT priority, UINT preemption_treshold)
+{
+    TX_RWLOCK_ASYNC* request;
+    UINT old;
+
+    /* Granting uses the reader counter mutex, which ISRs cannot */
+    if (TX_THREAD_GET_SYSTEM_STATE() || TX_NULL == tx_thread_identify())
+    {
+        return TX_CALLER_ERROR;
+    }
+    old = tx_interrupt_control(TX_INT_DISABLE);
+    if (TX_RWLOCK_MAX_ASYNC == rwlock_ptr->tx_rwlock_async_count)
+    {
+        tx_interrupt_control(old);
+        return TX_QUEUE_FULL;
+    }
+    request = rwlock_ptr->tx_rwlock_async + (rwlock_ptr->tx_rwlock_async_first + rwlock_ptr->tx_rwlock_async_count) % TX_RWLOCK_MAX_ASYNC;
+    request->tx_rwlock_async_taskq = taskq_ptr;
+    request->tx_rwlock_async_task.task_entry_function = task_entry_function;
+    request->tx_rwlock_async_task.task_input = task_input;
+    request->tx_rwlock_async_task.task_priority = priority;
+    request->tx_rwlock_async_task.task_preemption = preemption_treshold;
+    request->tx_rwlock_async_write = write;
+    rwlock_ptr->tx_rwlock_async_count++;
+    tx_interrupt_control(old);
+
+    /* Queued before trying, a release happening meanwhile grants it */
+    _tx_rwlock_async_grant(rwlock_ptr, TX_FALSE);
+    return rwlock_ptr->tx_rwlock_async_stalled ? TX_NOT_DONE : TX_SUCCESS;
+}
+
+UINT tx_rwlock_rget_async(TX_RWLOCK* rwlock_ptr, TX_TASKQ* taskq_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input, UINT priority, UINT preemption_treshold)
+{
+    return _tx_rwlock_async_request(rwlock_ptr, TX_FALSE, taskq_ptr, task_entry_function, task_input, priority, preemption_treshold);
+}
+
+UINT tx_rwlock_wget_async(TX_RWLOCK* rwlock_ptr, TX_TASKQ* taskq_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input, UINT priority, UINT preemption_treshold)
+{
+    return _tx_rwlock_async_request(rwlock_ptr, TX_TRUE, taskq_ptr, task_entry_function, task_input, priority, preemption_treshold);
+}
+
+UINT tx_rwlock_async_flush(TX_RWLOCK* rwlock_ptr)
+{
+    if (TX_THREAD_GET_SYSTEM_STATE() || TX_NULL == tx_thread_identify())
+    {
+        return TX_CALLER_ERROR;
+    }
+    if (rwlock_ptr->tx_rwlock_async_count)
+    {
+        _tx_rwlock_async_grant(rwlock_ptr, TX_FALSE);
+    }
+    return rwlock_ptr->tx_rwlock_async_count && rwlock_ptr->tx_rwlock_async_stalled ? TX_QUEUE_FULL : TX_SUCCESS;
+}
+
+#endif
+
 UINT tx_rwlock_rget(TX_RWLOCK* rwlock_ptr, ULONG wait_option)
 {
     ULONG start = tx_time_get();
@@ -29,37 +413,106 @@ UINT tx_rwlock_rget(TX_RWLOCK* rwlock_ptr, ULONG wait_option)
         if (!rwlock_ptr->tx_rwlock_rcounter)
         {
             /* Adjust wait option if mutex get was delayed */
-            if (TX_WAIT_FOREVER != wait_option)
+            wait_option = _tx_rwlock_remaining(start, wait_option);
+
+            /* Get write semaphore to block write access */
+#ifdef TX_RWLOCK_SPIN
+            ret = _tx_rwlock_spin(rwlock_ptr, wait_option);
+            if (TX_NO_INSTANCE == ret)
+#endif
             {
-                ULONG elapsed = tx_time_get() - start;
-                
-                wait_option = elapsed >= wait_option ? TX_NO_WAIT : wait_option - elapsed;
+#ifdef TX_ENABLE_EVENT_TRACE
+                if (TX_NO_WAIT != wait_option)
+                {
+                    ret = tx_semaphore_get(&(rwlock_ptr->tx_rwlock_sem_write), TX_NO_WAIT);
+                    if (TX_NO_INSTANCE == ret)
+                    {
+                        TX_SYNCX_TRACE(TX_SYNCX_TRACE_RWLOCK_RBLOCK, rwlock_ptr, wait_option, 0, 0);
+                        ret = tx_semaphore_get(&(rwlock_ptr->tx_rwlock_sem_write), wait_option);
+                    }
+                }
+                else
+#endif
+                ret = tx_semaphore_get(&(rwlock_ptr->tx_rwlock_sem_write), wait_option);
             }
-            /* Get write semaphore to block write access */
-            ret = tx_semaphore_get(&(rwlock_ptr->tx_rwlock_sem_write), wait_option);
         }
         if (TX_SUCCESS == ret)
         {
-            rwlock_ptr->tx_rwlock_rcounter++;            
+            rwlock_ptr->tx_rwlock_rcounter++;
+            TX_SYNCX_TRACE(TX_SYNCX_TRACE_RWLOCK_RGET, rwlock_ptr, rwlock_ptr->tx_rwlock_rcounter, 0, 0);
+#ifndef TX_RWLOCK_DISABLE_INHERIT
+            if (TX_INHERIT == rwlock_ptr->tx_rwlock_inherit)
+            {
+                _tx_rwlock_reader_add(rwlock_ptr, tx_thread_identify());
+            }
+#endif
         }
         /* Other readers can try to access (even if there is a writer) */
         ret = tx_mutex_put(&(rwlock_ptr->tx_rwlock_mtx_rcounter));
+#ifdef TX_RWLOCK_ENABLE_ASYNC
+        if (rwlock_ptr->tx_rwlock_async_count)
+        {
+            /* A read grant may have failed on the mutex */
+            _tx_rwlock_async_grant(rwlock_ptr, TX_FALSE);
+        }
+#endif
+    }
+    return ret;
+}
+
+UINT tx_rwlock_info_get(TX_RWLOCK* rwlock_ptr, CHAR** name, ULONG* readers, ULONG* untracked)
+{
+    if (name)
+    {
+        *name = rwlock_ptr->tx_rwlock_name;
+    }
+    if (readers)
+    {
+        *readers = rwlock_ptr->tx_rwlock_rcounter;
     }
-    return ret;            
+    if (untracked)
+    {
+#ifndef TX_RWLOCK_DISABLE_INHERIT
+        *untracked = rwlock_ptr->tx_rwlock_untracked;
+#else
+        *untracked = 0;
+#endif
+    }
+    return TX_SUCCESS;
 }
 
 UINT tx_rwlock_rput(TX_RWLOCK* rwlock_ptr)
 {
+#ifdef TX_RWLOCK_ENABLE_ASYNC
+    UINT handover = TX_FALSE;
+#endif
     UINT ret = tx_mutex_get(&(rwlock_ptr->tx_rwlock_mtx_rcounter), TX_WAIT_FOREVER);
 
     if (TX_SUCCESS == ret)
     {
+#ifndef TX_RWLOCK_DISABLE_INHERIT
+        if (TX_INHERIT == rwlock_ptr->tx_rwlock_inherit)
+        {
+            _tx_rwlock_reader_remove(rwlock_ptr, tx_thread_identify());
+        }
+#endif
+        TX_SYNCX_TRACE(TX_SYNCX_TRACE_RWLOCK_RPUT, rwlock_ptr, rwlock_ptr->tx_rwlock_rcounter - 1, 0, 0);
         if (!--(rwlock_ptr->tx_rwlock_rcounter))
         {
-            /* Last reader release write access */
+#ifdef TX_RWLOCK_ENABLE_ASYNC
+            /* Last reader hands write access over to pending requests, else releases it */
+            handover = 0 != rwlock_ptr->tx_rwlock_async_count;
+            if (!handover)
+#endif
             tx_semaphore_put(&(rwlock_ptr->tx_rwlock_sem_write));
         }
         ret = tx_mutex_put(&(rwlock_ptr->tx_rwlock_mtx_rcounter));
+#ifdef TX_RWLOCK_ENABLE_ASYNC
+        if (handover || rwlock_ptr->tx_rwlock_async_count)
+        {
+            _tx_rwlock_async_grant(rwlock_ptr, handover);
+        }
+#endif
     }
     return ret;
 }
@@ -68,12 +521,84 @@ UINT tx_rwlock_rput(TX_RWLOCK* rwlock_ptr)
 
 UINT tx_rwlock_wget(TX_RWLOCK* rwlock_ptr, ULONG wait_option)
 {
-    return tx_semaphore_get(&((rwlock_ptr)->tx_rwlock_sem_write), wait_option);
+    UINT ret = TX_NO_INSTANCE;
+
+#ifdef TX_RWLOCK_SPIN
+    ret = _tx_rwlock_spin(rwlock_ptr, wait_option);
+#endif
+    if (TX_NO_INSTANCE == ret && _TX_RWLOCK_TRY_FIRST(rwlock_ptr) && TX_NO_WAIT != wait_option)
+    {
+#ifndef TX_RWLOCK_DISABLE_INHERIT
+        ULONG start = tx_time_get();
+        UINT boosted = TX_FALSE;
+
+#endif
+        ret = tx_semaphore_get(&((rwlock_ptr)->tx_rwlock_sem_write), TX_NO_WAIT);
+        if (TX_NO_INSTANCE == ret)
+        {
+            TX_SYNCX_TRACE(TX_SYNCX_TRACE_RWLOCK_WBLOCK, rwlock_ptr, wait_option, rwlock_ptr->tx_rwlock_rcounter, 0);
+#ifndef TX_RWLOCK_DISABLE_INHERIT
+            if (TX_INHERIT == rwlock_ptr->tx_rwlock_inherit)
+            {
+                /* Write access is held, raise current readers to the writer priority before blocking */
+                ret = _tx_rwlock_readers_boost(rwlock_ptr, wait_option);
+                boosted = TX_TRUE;
+                wait_option = _tx_rwlock_remaining(start, wait_option);
+            }
+            /* Readers not raised because the mutex was not obtained in time are still waited for */
+            if (TX_SUCCESS == ret || TX_NO_INSTANCE == ret || TX_NOT_AVAILABLE == ret)
+#endif
+            ret = tx_semaphore_get(&((rwlock_ptr)->tx_rwlock_sem_write), wait_option);
+#ifndef TX_RWLOCK_DISABLE_INHERIT
+            if (boosted)
+            {
+                _tx_rwlock_readers_unboost(rwlock_ptr);
+            }
+#endif
+        }
+    }
+    else if (TX_NO_INSTANCE == ret)
+    {
+        ret = tx_semaphore_get(&((rwlock_ptr)->tx_rwlock_sem_write), wait_option);
+    }
+    if (TX_SUCCESS == ret)
+    {
+#ifdef TX_RWLOCK_SPIN
+        rwlock_ptr->tx_rwlock_writer = tx_thread_identify();
+#endif
+        TX_SYNCX_TRACE(TX_SYNCX_TRACE_RWLOCK_WGET, rwlock_ptr, 0, 0, 0);
+    }
+    return ret;
 }
 
 UINT tx_rwlock_wput(TX_RWLOCK* rwlock_ptr)
 {
+    TX_SYNCX_TRACE(TX_SYNCX_TRACE_RWLOCK_WPUT, rwlock_ptr, 0, 0, 0);
+#ifdef TX_RWLOCK_SPIN
+    rwlock_ptr->tx_rwlock_writer = TX_NULL;
+#endif
+#ifndef TX_RWLOCK_ENABLE_ASYNC
     return tx_semaphore_put(&((rwlock_ptr)->tx_rwlock_sem_write));
+#else
+    UINT ret = TX_SUCCESS;
+
+    if (rwlock_ptr->tx_rwlock_async_count)
+    {
+        /* Hand write access over to pending requests before threads suspended on it */
+        _tx_rwlock_async_grant(rwlock_ptr, TX_TRUE);
+    }
+    else
+    {
+        ret = tx_semaphore_put(&((rwlock_ptr)->tx_rwlock_sem_write));
+
+        /* A request queued meanwhile failed to get write access */
+        if (TX_SUCCESS == ret && rwlock_ptr->tx_rwlock_async_count)
+        {
+            _tx_rwlock_async_grant(rwlock_ptr, TX_FALSE);
+        }
+    }
+    return ret;
+#endif
 }
 
 UINT tx_rwlock_prioritize_write(TX_RWLOCK* rwlock_ptr)
@@ -81,4 +606,4 @@ UINT tx_rwlock_prioritize_write(TX_RWLOCK* rwlock_ptr)
     return tx_semaphore_prioritize(&((rwlock_ptr)->tx_rwlock_sem_write));
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,146 @@
+#include "tx_rwlock_array.h"
+
+UINT tx_rwlock_array_create(TX_RWLOCK_ARRAY* array_ptr, CHAR* name_ptr, TX_RWLOCK* stripes, ULONG stripe_count, ULONG span, UINT priority_inherit)
+{
+    UINT ret = TX_SUCCESS;
+    ULONG i;
+
+    if (!stripe_count || !span)
+    {
+        return TX_SIZE_ERROR;
+    }
+    array_ptr->tx_rwlock_array_name = name_ptr;
+    array_ptr->tx_rwlock_array_stripes = stripes;
+    array_ptr->tx_rwlock_array_count = stripe_count;
+    array_ptr->tx_rwlock_array_span = span;
+    for (i = 0; TX_SUCCESS == ret && i < stripe_count; i++)
+    {
+        ret = tx_rwlock_create(stripes + i, name_ptr, priority_inherit);
+    }
+    if (TX_SUCCESS != ret)
+    {
+        /* Delete the stripes created before the failing one */
+        for (i--; i > 0; i--)
+        {
+            tx_rwlock_delete(stripes + i - 1);
+        }
+    }
+    return ret;
+}
+
+UINT tx_rwlock_array_delete(TX_RWLOCK_ARRAY* array_ptr)
+{
+    UINT ret = TX_SUCCESS;
+
+    for (ULONG i = 0; i < array_ptr->tx_rwlock_array_count; i++)
+    {
+        UINT r = tx_rwlock_delete(array_ptr->tx_rwlock_array_stripes + i);
+
+        if (TX_SUCCESS == ret)
+        {
+            ret = r;
+        }
+    }
+    return ret;
+}
+
+TX_RWLOCK* tx_rwlock_array_key(TX_RWLOCK_ARRAY* array_ptr, ULONG key)
+{
+    /* Fibonacci hashing on 32 bits, consecutive keys land on different stripes */
+    ULONG hash = (ULONG)((key * 2654435769UL) & 0xFFFFFFFFUL);
+
+    return array_ptr->tx_rwlock_array_stripes + (hash >> 16) % array_ptr->tx_rwlock_array_count;
+}
+
+/* Check if a stripe guards some of the count indexes from first */
+static UINT _tx_rwlock_array_covered(TX_RWLOCK_ARRAY* array_ptr, ULONG first, ULONG count, ULONG stripe)
+{
+    ULONG n = array_ptr->tx_rwlock_array_count;
+    ULONG block_first = first / array_ptr->tx_rwlock_array_span;
+    ULONG blocks = (first + count - 1) / array_ptr->tx_rwlock_array_span - block_first;
+
+    return blocks + 1 >= n || (stripe + n - block_first % n) % n <= blocks;
+}
+
+static UINT _tx_rwlock_array_get(TX_RWLOCK_ARRAY* array_ptr, ULONG first, ULONG count, UINT write, ULONG wait_option)
+{
+    TX_RWLOCK* stripes = array_ptr->tx_rwlock_array_stripes;
+    UINT ret = TX_SUCCESS;
+    ULONG i;
+
+    if (!count)
+    {
+        return TX_SIZE_ERROR;
+    }
+    /* Canonical order: by increasing stripe number, whatever the first index */
+    for (i = 0; TX_SUCCESS == ret && i < array_ptr->tx_rwlock_array_count; i++)
+    {
+        if (_tx_rwlock_array_covered(array_ptr, first, count, i))
+        {
+            ret = write
+                ? tx_rwlock_wget(stripes + i, wait_option)
+                : tx_rwlock_rget(stripes + i, wait_option);
+        }
+    }
+    if (TX_SUCCESS != ret)
+    {
+        /* Release the stripes obtained before the failing one */
+        for (i--; i > 0; i--)
+        {
+            if (_tx_rwlock_array_covered(array_ptr, first, count, i - 1))
+            {
+                if (write)
+                {
+                    tx_rwlock_wput(stripes + i - 1);
+                }
+                else
+                {
+                    tx_rwlock_rput(stripes + i - 1);
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+static UINT _tx_rwlock_array_put(TX_RWLOCK_ARRAY* array_ptr, ULONG first, ULONG count, UINT write)
+{
+    TX_RWLOCK* stripes = array_ptr->tx_rwlock_array_stripes;
+    UINT ret = TX_SUCCESS;
+
+    for (ULONG i = array_ptr->tx_rwlock_array_count; count && i > 0; i--)
+    {
+        if (_tx_rwlock_array_covered(array_ptr, first, count, i - 1))
+        {
+            UINT r = write
+                ? tx_rwlock_wput(stripes + i - 1)
+                : tx_rwlock_rput(stripes + i - 1);
+
+            if (TX_SUCCESS == ret)
+            {
+                ret = r;
+            }
+        }
+    }
+    return ret;
+}
+
+UINT tx_rwlock_array_rget_range(TX_RWLOCK_ARRAY* array_ptr, ULONG first, ULONG count, ULONG wait_option)
+{
+    return _tx_rwlock_array_get(array_ptr, first, count, TX_FALSE, wait_option);
+}
+
+UINT tx_rwlock_array_rput_range(TX_RWLOCK_ARRAY* array_ptr, ULONG first, ULONG count)
+{
+    return _tx_rwlock_array_put(array_ptr, first, count, TX_FALSE);
+}
+
+UINT tx_rwlock_array_wget_range(TX_RWLOCK_ARRAY* array_ptr, ULONG first, ULONG count, ULONG wait_option)
+{
+    return _tx_rwlock_array_get(array_ptr, first, count, TX_TRUE, wait_option);
+}
+
+UINT tx_rwlock_array_wput_range(TX_RWLOCK_ARRAY* array_ptr, ULONG first, ULONG count)
+{
+    return _tx_rwlock_array_put(array_ptr, first, count, TX_TRUE);
+}
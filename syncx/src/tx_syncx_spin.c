@@ -0,0 +1,34 @@
+#include "tx_syncx_spin.h"
+
+#ifdef TX_SYNCX_ADAPTIVE_SPIN
+
+UINT _tx_syncx_spin_get(TX_SEMAPHORE* semaphore_ptr, TX_THREAD* owner_ptr, ULONG* budget_ptr)
+{
+    ULONG budget = *budget_ptr;
+    ULONG spins;
+
+    for (spins = 0; spins < budget; spins++)
+    {
+        /* Fields are only read as hints, the semaphore get decides */
+        if (owner_ptr && ((volatile TX_THREAD*)owner_ptr)->tx_thread_smp_core_executing >= TX_THREAD_SMP_MAX_CORES)
+        {
+            /* Owner not executing on a core: suspended, or ready but preempted, it cannot release soon */
+            return TX_NO_INSTANCE;
+        }
+        if (((volatile TX_SEMAPHORE*)semaphore_ptr)->tx_semaphore_count
+            && TX_SUCCESS == tx_semaphore_get(semaphore_ptr, TX_NO_WAIT))
+        {
+            /* Move the budget toward twice the spins needed */
+            budget = budget + (2 * spins + TX_SYNCX_SPIN_MIN) / 8 - budget / 8;
+            *budget_ptr = budget > TX_SYNCX_SPIN_MAX ? TX_SYNCX_SPIN_MAX : budget;
+            return TX_SUCCESS;
+        }
+        TX_SYNCX_SPIN_PAUSE();
+    }
+    /* Hold time exceeded the whole budget, spin less next time */
+    budget -= budget / 4;
+    *budget_ptr = budget < TX_SYNCX_SPIN_MIN ? TX_SYNCX_SPIN_MIN : budget;
+    return TX_NO_INSTANCE;
+}
+
+#endif
@@ -14,6 +14,33 @@ UINT tx_taskq_enter_exit_notify(VOID(*taskq_enter_exit_notify)(TX_TASKQ_ITEM* it
 #endif
 }
 
+VOID _tx_taskq_task_run(VOID* taskq_ptr, TX_TASKQ_ITEM* task)
+{
+    UINT old;
+    TX_THREAD* th = tx_thread_identify();
+
+    /* Only traced */
+    TX_PARAMETER_NOT_USED(taskq_ptr);
+    tx_thread_priority_change(th, task->task_priority, &old);
+    tx_thread_preemption_change(th, task->task_preemption, &old);
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
+    if (_taskq_enter_exit_notify)
+    {
+        _taskq_enter_exit_notify(task, TX_TRUE);
+    }                
+#endif
+    TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_START, taskq_ptr, task->task_entry_function, task->task_input, task->task_priority);
+    task->task_entry_function(task->task_input);
+    TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_END, taskq_ptr, task->task_entry_function, task->task_input, task->task_priority);
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
+    if (_taskq_enter_exit_notify)
+    {
+        _taskq_enter_exit_notify(task, TX_FALSE);
+    }
+#endif
+    tx_thread_priority_change(th, 0, &old);
+}
+
 VOID tx_taskq_runner_entry_function(ULONG task_pool_ptr)
 {
     TX_TASKQ* taskq = (TX_QUEUE*)task_pool_ptr;
@@ -23,25 +50,16 @@ VOID tx_taskq_runner_entry_function(ULONG task_pool_ptr)
     {
         if (TX_SUCCESS == tx_queue_receive(taskq, &task, TX_WAIT_FOREVER))
         {
-            UINT old;
-            TX_THREAD* th = tx_thread_identify();
-
-            tx_thread_priority_change(th, task.task_priority, &old);
-            tx_thread_preemption_change(th, task.task_preemption, &old);
-#ifndef TX_DISABLE_NOTIFY_CALLBACKS
-            if (_taskq_enter_exit_notify)
+            TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_RECEIVE, taskq, task.task_entry_function, task.task_input, task.task_priority);
+            if (TX_TASKQ_SOURCE == task.task_preemption)
             {
-                _taskq_enter_exit_notify(&task, TX_TRUE);
-            }                
-#endif
-            task.task_entry_function(task.task_input);
-#ifndef TX_DISABLE_NOTIFY_CALLBACKS
-            if (_taskq_enter_exit_notify)
+                /* Task source: get the task it provides */
+                task.task_entry_function((ULONG)&task);
+            }
+            if (task.task_entry_function)
             {
-                _taskq_enter_exit_notify(&task, TX_FALSE);
+                _tx_taskq_task_run(taskq, &task);
             }
-#endif
-            tx_thread_priority_change(th, 0, &old);
         }
         else
         {
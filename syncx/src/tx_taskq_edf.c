@@ -0,0 +1,154 @@
+#include "tx_taskq_edf.h"
+#include "tx_syncx_trace.h"
+
+#define _TX_TASKQ_EDF_BEFORE(a, b)  ((LONG)((a)->task_deadline - (b)->task_deadline) < 0)
+
+UINT tx_taskq_edf_create(TX_TASKQ_EDF* taskq_ptr, CHAR* name_ptr, VOID* taskq_start, ULONG taskq_size)
+{
+    if (TX_NULL == taskq_start)
+    {
+        return TX_PTR_ERROR;
+    }
+    if (taskq_size < sizeof(TX_TASKQ_EDF_ITEM))
+    {
+        return TX_SIZE_ERROR;
+    }
+    taskq_ptr->tx_taskq_edf_name = name_ptr;
+    taskq_ptr->tx_taskq_edf_heap = (TX_TASKQ_EDF_ITEM*)taskq_start;
+    taskq_ptr->tx_taskq_edf_capacity = taskq_size / sizeof(TX_TASKQ_EDF_ITEM);
+    taskq_ptr->tx_taskq_edf_count = 0;
+    taskq_ptr->tx_taskq_edf_misses = 0;
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
+    taskq_ptr->tx_taskq_edf_miss_notify = TX_NULL;
+#endif
+    return tx_semaphore_create(&(taskq_ptr->tx_taskq_edf_sem_pending), name_ptr, 0);
+}
+
+UINT tx_taskq_edf_delete(TX_TASKQ_EDF* taskq_ptr)
+{
+    return tx_semaphore_delete(&(taskq_ptr->tx_taskq_edf_sem_pending));
+}
+
+UINT tx_taskq_edf_miss_notify(TX_TASKQ_EDF* taskq_ptr, VOID(*taskq_miss_notify)(TX_TASKQ_EDF* taskq_ptr, TX_TASKQ_EDF_ITEM* item))
+{
+#ifdef TX_DISABLE_NOTIFY_CALLBACKS
+    return TX_FEATURE_NOT_ENABLED;
+#else
+    taskq_ptr->tx_taskq_edf_miss_notify = taskq_miss_notify;
+    return TX_SUCCESS;
+#endif
+}
+
+UINT tx_taskq_edf_info_get(TX_TASKQ_EDF* taskq_ptr, CHAR** name, ULONG* pending, ULONG* misses)
+{
+    if (name)
+    {
+        *name = taskq_ptr->tx_taskq_edf_name;
+    }
+    if (pending)
+    {
+        *pending = taskq_ptr->tx_taskq_edf_count;
+    }
+    if (misses)
+    {
+        *misses = taskq_ptr->tx_taskq_edf_misses;
+    }
+    return TX_SUCCESS;
+}
+
+UINT tx_taskq_edf_send(TX_TASKQ_EDF* taskq_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input, UINT priority, UINT preemption_treshold, ULONG deadline)
+{
+    TX_TASKQ_EDF_ITEM* heap = taskq_ptr->tx_taskq_edf_heap;
+    TX_TASKQ_EDF_ITEM item = { { task_entry_function, task_input, priority, preemption_treshold }, deadline };
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    ULONG i = taskq_ptr->tx_taskq_edf_count;
+    UINT ret;
+
+    if (i == taskq_ptr->tx_taskq_edf_capacity)
+    {
+        tx_interrupt_control(old);
+        return TX_QUEUE_FULL;
+    }
+    /* Sift up the new task in the deadline min-heap */
+    while (i && _TX_TASKQ_EDF_BEFORE(&item, heap + (i - 1) / 2))
+    {
+        heap[i] = heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap[i] = item;
+    taskq_ptr->tx_taskq_edf_count++;
+    tx_interrupt_control(old);
+
+    ret = tx_semaphore_put(&(taskq_ptr->tx_taskq_edf_sem_pending));
+    TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_SEND, taskq_ptr, task_entry_function, task_input, ret);
+    return ret;
+}
+
+static VOID _tx_taskq_edf_pop(TX_TASKQ_EDF* taskq_ptr, TX_TASKQ_EDF_ITEM* item)
+{
+    TX_TASKQ_EDF_ITEM* heap = taskq_ptr->tx_taskq_edf_heap;
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    ULONG count = --(taskq_ptr->tx_taskq_edf_count);
+    TX_TASKQ_EDF_ITEM last = heap[count];
+    ULONG i = 0;
+
+    *item = heap[0];
+
+    /* Sift down the last task from the root */
+    while (2 * i + 1 < count)
+    {
+        ULONG child = 2 * i + 1;
+
+        if (child + 1 < count && _TX_TASKQ_EDF_BEFORE(heap + child + 1, heap + child))
+        {
+            child++;
+        }
+        if (!_TX_TASKQ_EDF_BEFORE(heap + child, &last))
+        {
+            break;
+        }
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = last;
+    tx_interrupt_control(old);
+}
+
+VOID tx_taskq_edf_runner_entry_function(ULONG taskq_ptr)
+{
+    TX_TASKQ_EDF* taskq = (TX_TASKQ_EDF*)taskq_ptr;
+    TX_TASKQ_EDF_ITEM item;
+
+    while (TX_LOOP_FOREVER)
+    {
+        if (TX_SUCCESS == tx_semaphore_get(&(taskq->tx_taskq_edf_sem_pending), TX_WAIT_FOREVER))
+        {
+            _tx_taskq_edf_pop(taskq, &item);
+            TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_RECEIVE, taskq, item.task.task_entry_function, item.task.task_input, item.task.task_priority);
+            if ((LONG)(tx_time_get() - item.task_deadline) > 0)
+            {
+                /* Deadline passed, drop the task */
+                UINT old = tx_interrupt_control(TX_INT_DISABLE);
+
+                taskq->tx_taskq_edf_misses++;
+                tx_interrupt_control(old);
+                TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_MISS, taskq, item.task.task_entry_function, item.task.task_input, item.task_deadline);
+#ifndef TX_DISABLE_NOTIFY_CALLBACKS
+                if (taskq->tx_taskq_edf_miss_notify)
+                {
+                    taskq->tx_taskq_edf_miss_notify(taskq, &item);
+                }
+#endif
+            }
+            else
+            {
+                _tx_taskq_task_run(taskq, &(item.task));
+            }
+        }
+        else
+        {
+            /* Unexpected task queue receive failure */
+            break;
+        }
+    }
+}
@@ -0,0 +1,253 @@
+#include "tx_taskq_graph.h"
+
+/* Graph events: all the tasks ended, deferred tasks wait for room in the task queue while no task of the graph is active */
+#define TX_TASKQ_GRAPH_DONE     0x1
+#define TX_TASKQ_GRAPH_STALLED  0x2
+
+#define _TX_TASKQ_GRAPH_RUNNING(graph_ptr)  ((graph_ptr)->tx_taskq_graph_remaining != 0)
+
+static VOID _tx_taskq_graph_node_run(ULONG node_ptr);
+
+UINT tx_taskq_graph_create(TX_TASKQ_GRAPH* graph_ptr, CHAR* name_ptr, TX_TASKQ* taskq_ptr)
+{
+    graph_ptr->tx_taskq_graph_name = name_ptr;
+    graph_ptr->tx_taskq_graph_taskq = taskq_ptr;
+    graph_ptr->tx_taskq_graph_nodes = TX_NULL;
+    graph_ptr->tx_taskq_graph_node_count = 0;
+    graph_ptr->tx_taskq_graph_active = 0;
+    graph_ptr->tx_taskq_graph_deferred = TX_NULL;
+    graph_ptr->tx_taskq_graph_remaining = 0;
+    UINT ret = tx_event_flags_create(&(graph_ptr->tx_taskq_graph_events), name_ptr);
+
+    if (TX_SUCCESS == ret)
+    {
+        ret = tx_event_flags_set(&(graph_ptr->tx_taskq_graph_events), TX_TASKQ_GRAPH_DONE, TX_OR);
+    }
+    return ret;
+}
+
+UINT tx_taskq_graph_delete(TX_TASKQ_GRAPH* graph_ptr)
+{
+    return tx_event_flags_delete(&(graph_ptr->tx_taskq_graph_events));
+}
+
+static ULONG _tx_taskq_graph_remaining(ULONG start, ULONG wait_option)
+{
+    if (TX_WAIT_FOREVER != wait_option)
+    {
+        ULONG elapsed = tx_time_get() - start;
+
+        wait_option = elapsed >= wait_option ? TX_NO_WAIT : wait_option - elapsed;
+    }
+    return wait_option;
+}
+
+UINT tx_taskq_graph_node_add(TX_TASKQ_GRAPH* graph_ptr, TX_TASKQ_NODE* node_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input, UINT priority, UINT preemption_treshold)
+{
+    TX_TASKQ_NODE** link = &(graph_ptr->tx_taskq_graph_nodes);
+
+    if (_TX_TASKQ_GRAPH_RUNNING(graph_ptr))
+    {
+        return TX_NOT_DONE;
+    }
+    node_ptr->tx_taskq_node_entry_function = task_entry_function;
+    node_ptr->tx_taskq_node_input = task_input;
+    node_ptr->tx_taskq_node_priority = priority;
+    node_ptr->tx_taskq_node_preemption = preemption_treshold;
+    node_ptr->tx_taskq_node_dependencies = 0;
+    node_ptr->tx_taskq_node_pending = 0;
+    node_ptr->tx_taskq_node_successors = TX_NULL;
+    node_ptr->tx_taskq_node_graph = graph_ptr;
+    node_ptr->tx_taskq_node_next = TX_NULL;
+    node_ptr->tx_taskq_node_deferred = TX_NULL;
+
+    /* Keep declaration order, tasks without dependency are sent in this order */
+    while (*link)
+    {
+        link = &((*link)->tx_taskq_node_next);
+    }
+    *link = node_ptr;
+    graph_ptr->tx_taskq_graph_node_count++;
+    return TX_SUCCESS;
+}
+
+UINT tx_taskq_graph_edge_add(TX_TASKQ_GRAPH* graph_ptr, TX_TASKQ_EDGE* edge_ptr, TX_TASKQ_NODE* from_ptr, TX_TASKQ_NODE* to_ptr)
+{
+    TX_TASKQ_EDGE** link = &(from_ptr->tx_taskq_node_successors);
+
+    if (from_ptr->tx_taskq_node_graph != graph_ptr || to_ptr->tx_taskq_node_graph != graph_ptr)
+    {
+        return TX_PTR_ERROR;
+    }
+    if (_TX_TASKQ_GRAPH_RUNNING(graph_ptr))
+    {
+        return TX_NOT_DONE;
+    }
+    edge_ptr->tx_taskq_edge_to = to_ptr;
+    edge_ptr->tx_taskq_edge_next = TX_NULL;
+
+    /* Keep declaration order, successors are released in this order */
+    while (*link)
+    {
+        link = &((*link)->tx_taskq_edge_next);
+    }
+    *link = edge_ptr;
+    to_ptr->tx_taskq_node_dependencies++;
+    return TX_SUCCESS;
+}
+
+/* Send a released task, or defer it on a full task queue */
+static UINT _tx_taskq_graph_node_release(TX_TASKQ_NODE* node_ptr, ULONG wait_option)
+{
+    TX_TASKQ_GRAPH* graph = node_ptr->tx_taskq_node_graph;
+    TX_TASKQ_ITEM task = {
+        _tx_taskq_graph_node_run, (ULONG)node_ptr,
+        node_ptr->tx_taskq_node_priority, node_ptr->tx_taskq_node_preemption
+    };
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    UINT stalled;
+    UINT ret;
+
+    /* Counted first, the task may end before the send returns */
+    graph->tx_taskq_graph_active++;
+    tx_interrupt_control(old);
+    ret = tx_queue_send(graph->tx_taskq_graph_taskq, &task, wait_option);
+    if (TX_SUCCESS != ret)
+    {
+        /* Deferred tasks are sent by the next active task ending, else by a thread waiting for the graph */
+        old = tx_interrupt_control(TX_INT_DISABLE);
+        stalled = !--(graph->tx_taskq_graph_active);
+        node_ptr->tx_taskq_node_deferred = graph->tx_taskq_graph_deferred;
+        graph->tx_taskq_graph_deferred = node_ptr;
+        tx_interrupt_control(old);
+        if (stalled)
+        {
+            tx_event_flags_set(&(graph->tx_taskq_graph_events), TX_TASKQ_GRAPH_STALLED, TX_OR);
+        }
+    }
+    return ret;
+}
+
+/* Send the deferred tasks until one cannot be sent, runners only flush with TX_NO_WAIT not to block on their own task queue */
+static UINT _tx_taskq_graph_flush(TX_TASKQ_GRAPH* graph_ptr, ULONG wait_option)
+{
+    UINT ret = TX_SUCCESS;
+
+    while (TX_SUCCESS == ret)
+    {
+        UINT old = tx_interrupt_control(TX_INT_DISABLE);
+        TX_TASKQ_NODE* node = graph_ptr->tx_taskq_graph_deferred;
+
+        if (TX_NULL == node)
+        {
+            tx_interrupt_control(old);
+            break;
+        }
+        graph_ptr->tx_taskq_graph_deferred = node->tx_taskq_node_deferred;
+        tx_interrupt_control(old);
+        ret = _tx_taskq_graph_node_release(node, wait_option);
+    }
+    return ret;
+}
+
+static VOID _tx_taskq_graph_node_run(ULONG node_ptr)
+{
+    TX_TASKQ_NODE* node = (TX_TASKQ_NODE*)node_ptr;
+    TX_TASKQ_GRAPH* graph = node->tx_taskq_node_graph;
+    ULONG remaining;
+    UINT old;
+
+    node->tx_taskq_node_entry_function(node->tx_taskq_node_input);
+
+    /* Release the successors whose dependencies all ended */
+    for (TX_TASKQ_EDGE* edge = node->tx_taskq_node_successors; edge; edge = edge->tx_taskq_edge_next)
+    {
+        TX_TASKQ_NODE* next = edge->tx_taskq_edge_to;
+        ULONG pending;
+
+        old = tx_interrupt_control(TX_INT_DISABLE);
+        pending = --(next->tx_taskq_node_pending);
+        tx_interrupt_control(old);
+        if (!pending)
+        {
+            _tx_taskq_graph_node_release(next, TX_NO_WAIT);
+        }
+    }
+    old = tx_interrupt_control(TX_INT_DISABLE);
+    graph->tx_taskq_graph_active--;
+    tx_interrupt_control(old);
+    _tx_taskq_graph_flush(graph, TX_NO_WAIT);
+
+    old = tx_interrupt_control(TX_INT_DISABLE);
+    remaining = --(graph->tx_taskq_graph_remaining);
+    tx_interrupt_control(old);
+    if (!remaining)
+    {
+        tx_event_flags_set(&(graph->tx_taskq_graph_events), TX_TASKQ_GRAPH_DONE, TX_OR);
+    }
+}
+
+UINT tx_taskq_graph_submit(TX_TASKQ_GRAPH* graph_ptr)
+{
+    TX_TASKQ_NODE* node;
+    UINT ret;
+
+    if (_TX_TASKQ_GRAPH_RUNNING(graph_ptr))
+    {
+        return TX_NOT_DONE;
+    }
+    ret = tx_event_flags_set(&(graph_ptr->tx_taskq_graph_events), ~(ULONG)(TX_TASKQ_GRAPH_DONE | TX_TASKQ_GRAPH_STALLED), TX_AND);
+    if (TX_SUCCESS != ret)
+    {
+        return ret;
+    }
+    if (!graph_ptr->tx_taskq_graph_node_count)
+    {
+        return tx_event_flags_set(&(graph_ptr->tx_taskq_graph_events), TX_TASKQ_GRAPH_DONE, TX_OR);
+    }
+    graph_ptr->tx_taskq_graph_remaining = graph_ptr->tx_taskq_graph_node_count;
+    /* Reset all dependency counters before releasing any task */
+    graph_ptr->tx_taskq_graph_active = 0;
+    graph_ptr->tx_taskq_graph_deferred = TX_NULL;
+    for (node = graph_ptr->tx_taskq_graph_nodes; node; node = node->tx_taskq_node_next)
+    {
+        node->tx_taskq_node_pending = node->tx_taskq_node_dependencies;
+    }
+    for (node = graph_ptr->tx_taskq_graph_nodes; node; node = node->tx_taskq_node_next)
+    {
+        if (!node->tx_taskq_node_dependencies)
+        {
+            _tx_taskq_graph_node_release(node, TX_NO_WAIT);
+        }
+    }
+    _tx_taskq_graph_flush(graph_ptr, TX_NO_WAIT);
+    return TX_SUCCESS;
+}
+
+UINT tx_taskq_graph_wait(TX_TASKQ_GRAPH* graph_ptr, ULONG wait_option)
+{
+    ULONG start = tx_time_get();
+    ULONG actual = 0;
+    UINT ret = tx_event_flags_get(&(graph_ptr->tx_taskq_graph_events), TX_TASKQ_GRAPH_DONE | TX_TASKQ_GRAPH_STALLED, TX_OR, &actual, wait_option);
+
+    while (TX_SUCCESS == ret && !(actual & TX_TASKQ_GRAPH_DONE))
+    {
+        /* No task of the graph is active to send the deferred ones, wait for room in the task queue on their behalf */
+        ULONG remaining = _tx_taskq_graph_remaining(start, wait_option);
+
+        ret = tx_event_flags_set(&(graph_ptr->tx_taskq_graph_events), ~(ULONG)TX_TASKQ_GRAPH_STALLED, TX_AND);
+        if (TX_SUCCESS == ret)
+        {
+            ret = _tx_taskq_graph_flush(graph_ptr, remaining);
+        }
+        if (TX_QUEUE_FULL == ret && TX_NO_WAIT == remaining)
+        {
+            ret = TX_NO_EVENTS;
+        }
+        else if (TX_SUCCESS == ret || TX_QUEUE_FULL == ret)
+        {
+            ret = tx_event_flags_get(&(graph_ptr->tx_taskq_graph_events), TX_TASKQ_GRAPH_DONE | TX_TASKQ_GRAPH_STALLED, TX_OR, &actual, _tx_taskq_graph_remaining(start, wait_option));
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,252 @@
+#include "tx_taskq_isr.h"
+#include "tx_syncx_trace.h"
+
+/* Atomic compare and swap of a ULONG, and memory barrier */
+#if !defined(TX_TASKQ_ISR_CAS) && defined(__GNUC__)
+#define TX_TASKQ_ISR_CAS(ptr, expected, desired)    __sync_bool_compare_and_swap(ptr, expected, desired)
+#define TX_TASKQ_ISR_BARRIER()                      __sync_synchronize()
+#elif !defined(TX_TASKQ_ISR_CAS) && defined(_MSC_VER)
+#include <intrin.h>
+#define TX_TASKQ_ISR_CAS(ptr, expected, desired)    (_InterlockedCompareExchange((volatile long*)(ptr), (long)(desired), (long)(expected)) == (long)(expected))
+#define TX_TASKQ_ISR_BARRIER()                      _ReadWriteBarrier()
+#elif !defined(TX_TASKQ_ISR_CAS)
+/* No atomic instruction known, fall back on a critical section: still ISR safe, but single core only */
+static UINT _tx_taskq_isr_cas(volatile ULONG* ptr, ULONG expected, ULONG desired)
+{
+    UINT old = tx_interrupt_control(TX_INT_DISABLE);
+    UINT swapped = *ptr == expected;
+
+    if (swapped)
+    {
+        *ptr = desired;
+    }
+    tx_interrupt_control(old);
+    return swapped;
+}
+#define TX_TASKQ_ISR_CAS(ptr, expected, desired)    _tx_taskq_isr_cas(ptr, expected, desired)
+#endif
+#ifndef TX_TASKQ_ISR_BARRIER
+#define TX_TASKQ_ISR_BARRIER()
+#endif
+
+static VOID _tx_taskq_isr_drain(ULONG isr_ptr);
+
+UINT tx_taskq_isr_create(TX_TASKQ_ISR* isr_ptr, CHAR* name_ptr, TX_TASKQ* taskq_ptr, VOID* ring_start, ULONG ring_size)
+{
+    ULONG count = ring_size / sizeof(TX_TASKQ_ISR_SLOT);
+
+    if (TX_NULL == taskq_ptr || TX_NULL == ring_start)
+    {
+        return TX_PTR_ERROR;
+    }
+    if (!count || (count & (count - 1)))
+    {
+        return TX_SIZE_ERROR;
+    }
+    isr_ptr->tx_taskq_isr_name = name_ptr;
+    isr_ptr->tx_taskq_isr_taskq = taskq_ptr;
+    isr_ptr->tx_taskq_isr_slots = (TX_TASKQ_ISR_SLOT*)ring_start;
+    isr_ptr->tx_taskq_isr_mask = count - 1;
+    isr_ptr->tx_taskq_isr_head = 0;
+    isr_ptr->tx_taskq_isr_tail = 0;
+    isr_ptr->tx_taskq_isr_drain_pending = TX_FALSE;
+    isr_ptr->tx_taskq_isr_overflows = 0;
+    isr_ptr->tx_taskq_isr_stalls = 0;
+
+    /* Each slot sequence tells the ring position it is free for */
+    for (ULONG i = 0; i < count; i++)
+    {
+        isr_ptr->tx_taskq_isr_slots[i].tx_taskq_isr_slot_sequence = i;
+    }
+    return TX_SUCCESS;
+}
+
+UINT tx_taskq_isr_delete(TX_TASKQ_ISR* isr_ptr)
+{
+    isr_ptr->tx_taskq_isr_taskq = TX_NULL;
+    return TX_SUCCESS;
+}
+
+UINT tx_taskq_isr_info_get(TX_TASKQ_ISR* isr_ptr, CHAR** name, ULONG* pending, ULONG* overflows, ULONG* stalls)
+{
+    if (name)
+    {
+        *name = isr_ptr->tx_taskq_isr_name;
+    }
+    if (pending)
+    {
+        *pending = isr_ptr->tx_taskq_isr_head - isr_ptr->tx_taskq_isr_tail;
+    }
+    if (overflows)
+    {
+        *overflows = isr_ptr->tx_taskq_isr_overflows;
+    }
+    if (stalls)
+    {
+        *stalls = isr_ptr->tx_taskq_isr_stalls;
+    }
+    return TX_SUCCESS;
+}
+
+/* Increment a counter shared with ISRs, return its new value */
+static ULONG _tx_taskq_isr_count(volatile ULONG* counter_ptr)
+{
+    ULONG count;
+
+    do
+    {
+        count = *counter_ptr;
+    } while (!TX_TASKQ_ISR_CAS(counter_ptr, count, count + 1));
+    return count + 1;
+}
+
+/* Send a drain item, the caller owns the pending drain */
+static UINT _tx_taskq_isr_send_drain(TX_TASKQ_ISR* isr_ptr, UINT front, ULONG wait_option)
+{
+    TX_TASKQ_ITEM drain = { _tx_taskq_isr_drain, (ULONG)isr_ptr, 0, TX_TASKQ_SOURCE };
+    UINT ret = front
+        ? tx_queue_front_send(isr_ptr->tx_taskq_isr_taskq, &drain, wait_option)
+        : tx_queue_send(isr_ptr->tx_taskq_isr_taskq, &drain, wait_option);
+
+    if (TX_SUCCESS != ret)
+    {
+        /* Task queue full: the next submission or flush tries again */
+        isr_ptr->tx_taskq_isr_drain_pending = TX_FALSE;
+    }
+    return ret;
+}
+
+/* Send a drain item unless one is already pending */
+static UINT _tx_taskq_isr_wake(TX_TASKQ_ISR* isr_ptr, UINT front, ULONG wait_option)
+{
+    return TX_TASKQ_ISR_CAS(&(isr_ptr->tx_taskq_isr_drain_pending), TX_FALSE, TX_TRUE)
+        ? _tx_taskq_isr_send_drain(isr_ptr, front, wait_option)
+        : TX_SUCCESS;
+}
+
+/* Count and trace a drain item that could not be sent */
+static VOID _tx_taskq_isr_stall(TX_TASKQ_ISR* isr_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input)
+{
+    ULONG stalls = _tx_taskq_isr_count(&(isr_ptr->tx_taskq_isr_stalls));
+
+    TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_STALL, isr_ptr, task_entry_function, task_input, stalls);
+    TX_PARAMETER_NOT_USED(stalls);
+}
+
+UINT tx_taskq_isr_send(TX_TASKQ_ISR* isr_ptr, VOID(*task_entry_function)(ULONG), ULONG task_input, UINT priority, UINT preemption_treshold)
+{
+    TX_TASKQ_ISR_SLOT* slot;
+    ULONG pos = isr_ptr->tx_taskq_isr_head;
+    UINT ret;
+
+    /* Reserve the slot at head position */
+    while (TX_LOOP_FOREVER)
+    {
+        LONG diff;
+
+        slot = isr_ptr->tx_taskq_isr_slots + (pos & isr_ptr->tx_taskq_isr_mask);
+        diff = (LONG)(slot->tx_taskq_isr_slot_sequence - pos);
+        if (!diff && TX_TASKQ_ISR_CAS(&(isr_ptr->tx_taskq_isr_head), pos, pos + 1))
+        {
+            break;
+        }
+        if (diff < 0)
+        {
+            /* Slot not consumed yet since last round */
+            ULONG overflows = _tx_taskq_isr_count(&(isr_ptr->tx_taskq_isr_overflows));
+
+            TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_OVERFLOW, isr_ptr, task_entry_function, task_input, overflows);
+
+            /* The drain item may have been lost on a full task queue */
+            _tx_taskq_isr_wake(isr_ptr, TX_TRUE, TX_NO_WAIT);
+            return TX_QUEUE_FULL;
+        }
+        pos = isr_ptr->tx_taskq_isr_head;
+    }
+    slot->tx_taskq_isr_slot_task.task_entry_function = task_entry_function;
+    slot->tx_taskq_isr_slot_task.task_input = task_input;
+    slot->tx_taskq_isr_slot_task.task_priority = priority;
+    slot->tx_taskq_isr_slot_task.task_preemption = preemption_treshold;
+    TX_TASKQ_ISR_BARRIER();
+
+    /* Publish the task to the runners */
+    slot->tx_taskq_isr_slot_sequence = pos + 1;
+    ret = _tx_taskq_isr_wake(isr_ptr, TX_TRUE, TX_NO_WAIT);
+    TX_SYNCX_TRACE(TX_SYNCX_TRACE_TASKQ_SEND, isr_ptr, task_entry_function, task_input, ret);
+    if (TX_SUCCESS != ret)
+    {
+        _tx_taskq_isr_stall(isr_ptr, task_entry_function, task_input);
+        return TX_NOT_DONE;
+    }
+    return TX_SUCCESS;
+}
+
+UINT tx_taskq_isr_flush(TX_TASKQ_ISR* isr_ptr, ULONG wait_option)
+{
+    return isr_ptr->tx_taskq_isr_head != isr_ptr->tx_taskq_isr_tail
+        ? _tx_taskq_isr_wake(isr_ptr, TX_FALSE, wait_option)
+        : TX_SUCCESS;
+}
+
+static UINT _tx_taskq_isr_pop(TX_TASKQ_ISR* isr_ptr, TX_TASKQ_ITEM* task)
+{
+    TX_TASKQ_ISR_SLOT* slot;
+    ULONG pos = isr_ptr->tx_taskq_isr_tail;
+
+    while (TX_LOOP_FOREVER)
+    {
+        LONG diff;
+
+        slot = isr_ptr->tx_taskq_isr_slots + (pos & isr_ptr->tx_taskq_isr_mask);
+        diff = (LONG)(slot->tx_taskq_isr_slot_sequence - (pos + 1));
+        if (!diff && TX_TASKQ_ISR_CAS(&(isr_ptr->tx_taskq_isr_tail), pos, pos + 1))
+        {
+            break;
+        }
+        if (diff < 0)
+        {
+            /* Empty, or next task not published yet */
+            return TX_FALSE;
+        }
+        pos = isr_ptr->tx_taskq_isr_tail;
+    }
+    *task = slot->tx_taskq_isr_slot_task;
+    TX_TASKQ_ISR_BARRIER();
+
+    /* Free the slot for the next round */
+    slot->tx_taskq_isr_slot_sequence = pos + isr_ptr->tx_taskq_isr_mask + 1;
+    return TX_TRUE;
+}
+
+/* Task source of the ring: replace the drain item with the next task of the ring */
+static VOID _tx_taskq_isr_drain(ULONG item_ptr)
+{
+    TX_TASKQ_ITEM* item = (TX_TASKQ_ITEM*)item_ptr;
+    TX_TASKQ_ISR* isr = (TX_TASKQ_ISR*)item->task_input;
+
+    /* The drain stays pending while the ring has tasks, so submissions do not send another drain item meanwhile */
+    if (!_tx_taskq_isr_pop(isr, item))
+    {
+        item->task_entry_function = TX_NULL;
+    }
+    else if (isr->tx_taskq_isr_head != isr->tx_taskq_isr_tail)
+    {
+        /* More tasks: queue the next drain item behind the other tasks, they must not starve under an interrupt storm */
+        if (TX_SUCCESS != _tx_taskq_isr_send_drain(isr, TX_FALSE, TX_NO_WAIT))
+        {
+            _tx_taskq_isr_stall(isr, item->task_entry_function, item->task_input);
+        }
+        return;
+    }
+
+    /* Ring empty: tasks published from now on send a new drain item */
+    isr->tx_taskq_isr_drain_pending = TX_FALSE;
+    TX_TASKQ_ISR_BARRIER();
+
+    /* Tasks published before the reset found the drain pending and sent none */
+    if (isr->tx_taskq_isr_head != isr->tx_taskq_isr_tail
+        && TX_SUCCESS != _tx_taskq_isr_wake(isr, TX_FALSE, TX_NO_WAIT))
+    {
+        _tx_taskq_isr_stall(isr, TX_NULL, 0);
+    }
+}